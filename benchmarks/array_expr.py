@@ -0,0 +1,25 @@
+from ltypes import i32, f64
+from numpy import empty
+
+def main():
+    # Whole array expressions, each one is lowered to a loop over the arrays
+    n: i32 = 10000
+    a: f64[10000] = empty(10000)
+    b: f64[10000] = empty(10000)
+    c: f64[10000] = empty(10000)
+    i: i32
+    r: i32
+    s: f64
+    for i in range(n):
+        a[i] = f64(i % 17)
+        b[i] = f64(i % 13) + 1.0
+    for r in range(2000):
+        c = 0.5*a + 0.25*b
+        a = 0.9*c + 0.1*b - 0.01*a
+        b = 0.5*(a + b) + 1.0/(b + 1.0)
+    s = 0.0
+    for i in range(n):
+        s += a[i] + b[i] + c[i]
+    print(s)
+
+main()
@@ -0,0 +1,203 @@
+#!/usr/bin/env python
+
+"""
+Generates LPython programs that grow along one axis, to benchmark how the
+compile time scales with the size of the input. Every generator returns a
+dictionary from file names to sources, the program to compile is `main.py`.
+
+Run as a script it prints the main file, by default the one with 10000
+functions:
+
+    python bench_gen.py
+    python bench_gen.py statements 5000
+"""
+
+import sys
+
+
+def gen_functions(n):
+    # `n` small functions, all called from a driver
+    A_functions = ""
+    calls = ""
+    for i in range(n):
+        func_A = f"""
+def A{i}(x: i32) -> i32:
+    y: i32
+    z: i32
+    y = {i}
+    z = 5
+    x = x + y * z
+    return x
+"""
+        A_functions += func_A
+        calls += f"    y = A{i}(y)\n"
+
+    source = f"""\
+from ltypes import i32
+
+{A_functions}
+
+def Driver(test_val: i32) -> i32:
+    y: i32
+    y = test_val
+{calls}
+    return y
+
+def Main0():
+    print(Driver(5))
+
+Main0()
+"""
+    return {"main.py": source}
+
+
+def gen_statements(n):
+    # A single function with `n` statements
+    body = ""
+    for i in range(n):
+        body += f"    z = z + y * {i % 7 + 1} - {i}\n"
+        if i % 10 == 9:
+            body += f"    y = z % {i + 1}\n"
+    source = f"""\
+from ltypes import i32
+
+def f(x: i32) -> i32:
+    y: i32
+    z: i32
+    y = x
+    z = 0
+{body}
+    return z
+
+print(f(5))
+"""
+    return {"main.py": source}
+
+
+def gen_nesting(n):
+    # `n` nested blocks, alternating between `if` and `for`
+    decls = ""
+    body = ""
+    indent = "    "
+    for i in range(n):
+        if i % 2 == 0:
+            body += f"{indent}if x > {i}:\n"
+        else:
+            decls += f"    i{i}: i32\n"
+            body += f"{indent}for i{i} in range(2):\n"
+        indent += "    "
+    body += f"{indent}y = y + 1\n"
+    source = f"""\
+from ltypes import i32
+
+def f(x: i32) -> i32:
+    y: i32
+{decls}
+    y = 0
+{body}
+    return y
+
+print(f({n}))
+"""
+    return {"main.py": source}
+
+
+def gen_imports(n):
+    # The main module imports a function from each of `n` modules
+    files = {}
+    imports = ""
+    calls = ""
+    for i in range(n):
+        files[f"bench_mod{i}.py"] = f"""\
+from ltypes import i32
+
+def f{i}(x: i32) -> i32:
+    return x + {i}
+"""
+        imports += f"from bench_mod{i} import f{i}\n"
+        calls += f"    y = f{i}(y)\n"
+    files["main.py"] = f"""\
+from ltypes import i32
+{imports}
+def main():
+    y: i32
+    y = 0
+{calls}
+    print(y)
+
+main()
+"""
+    return files
+
+
+def gen_array_constant(n):
+    # A list constant with `n` elements
+    elements = ", ".join(str(i % 1000) for i in range(n))
+    source = f"""\
+from ltypes import i32
+
+def main():
+    x: list[i32] = [{elements}]
+    i: i32
+    s: i32
+    s = 0
+    for i in range(len(x)):
+        s += x[i]
+    print(s)
+
+main()
+"""
+    return {"main.py": source}
+
+
+def gen_classes(n):
+    # A chain of `n` dataclasses, each one a member of the next one. LPython
+    # does not support inheritance, so nesting is the closest thing to a
+    # deep class hierarchy.
+    classes = """\
+@dataclass
+class C0:
+    x: i32
+"""
+    decls = "    c0: C0 = C0(0)\n"
+    for i in range(1, n):
+        classes += f"""
+@dataclass
+class C{i}:
+    p: C{i - 1}
+    x: i32
+"""
+        decls += f"    c{i}: C{i} = C{i}(c{i - 1}, {i})\n"
+    chain = f"c{n - 1}" + ".p" * (n - 1) + ".x"
+    source = f"""\
+from ltypes import i32, dataclass
+
+{classes}
+
+def main():
+{decls}
+    print({chain})
+
+main()
+"""
+    return {"main.py": source}
+
+
+AXES = {
+    "functions": gen_functions,
+    "statements": gen_statements,
+    "nesting": gen_nesting,
+    "imports": gen_imports,
+    "array_constant": gen_array_constant,
+    "classes": gen_classes,
+}
+
+
+def generate(axis, n):
+    return AXES[axis](n)
+
+
+if __name__ == "__main__":
+    axis = sys.argv[1] if len(sys.argv) > 1 else "functions"
+    n = int(sys.argv[2]) if len(sys.argv) > 2 else 10000
+    print(generate(axis, n)["main.py"])
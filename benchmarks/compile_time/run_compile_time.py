@@ -0,0 +1,251 @@
+#!/usr/bin/env python
+
+"""
+Compile time scalability benchmarks.
+
+For every axis of `bench_gen.py` (number of functions, statements per
+function, nesting depth, number of imports, size of array constants, depth of
+class nesting) programs of increasing size are generated and compiled with
+`lpython --time-report`. For every compiler phase the scaling exponent `k` of
+`time ~ size**k` is fitted over the sizes; a phase that grows faster than
+`--max-exponent` (super-linear behaviour) makes the run fail:
+
+    python run_compile_time.py
+    python run_compile_time.py -a functions nesting --scale 0.5 --plot out.png
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+from bench_gen import AXES, generate
+
+BASE_DIR = os.path.dirname(os.path.realpath(__file__))
+LPYTHON_PATH = f"{BASE_DIR}/../../src/bin"
+
+# Sizes for every axis, each size twice the previous one
+DEFAULT_SIZES = {
+    "functions": [1000, 2000, 4000, 8000],
+    "statements": [1000, 2000, 4000, 8000],
+    "nesting": [25, 50, 100, 200],
+    "imports": [25, 50, 100, 200],
+    "array_constant": [2000, 4000, 8000, 16000],
+    "classes": [10, 20, 40, 80],
+}
+
+# Phases that take less than this (in ms) at the largest size are too noisy
+# to fit an exponent to
+MIN_TIME = 5.0
+
+TIME_REPORT_LINE = re.compile(r"^(\s*)(.+): ([-+0-9.eE]+)ms$")
+
+
+def parse_time_report(output):
+    """
+    Returns {phase: ms} from the output of `--time-report`. The individual
+    ASR passes (indented under "ASR passes") are returned as "pass <name>".
+    """
+    times = {}
+    for line in output.splitlines():
+        m = TIME_REPORT_LINE.match(line)
+        if m is None:
+            continue
+        name = m.group(2).strip()
+        if m.group(1):
+            name = f"pass {name}"
+        times[name] = times.get(name, 0.0) + float(m.group(3))
+    return times
+
+
+def compile_once(files, args):
+    """
+    Compiles the generated program, returns {phase: ms} including the total
+    wall time of the compiler process.
+    """
+    workdir = tempfile.mkdtemp(prefix="lpython-compile-time-")
+    try:
+        for name, source in files.items():
+            with open(os.path.join(workdir, name), "w") as f:
+                f.write(source)
+        cmd = [args.lpython, "--time-report"]
+        if args.fast:
+            cmd.append("--fast")
+        if args.backend == "llvm":
+            # Only compile to an object file, the linker is not ours to time
+            cmd += ["-c", "main.py", "-o", "main.o"]
+        else:
+            cmd += ["--backend", args.backend, "main.py", "-o", "main"]
+        start = time.perf_counter()
+        p = subprocess.run(cmd, capture_output=True, text=True, cwd=workdir)
+        total = 1000 * (time.perf_counter() - start)
+        if p.returncode != 0:
+            out = (p.stdout + p.stderr).strip().splitlines()
+            raise RuntimeError(out[-1] if out else
+                    f"exit status {p.returncode}")
+        times = parse_time_report(p.stdout)
+        times["Total"] = total
+        return times
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+
+
+def scaling_exponent(sizes, times):
+    """
+    Least squares fit of log(time) = k*log(size) + c, returns k.
+    """
+    xs = [math.log(s) for s in sizes]
+    ys = [math.log(max(t, 1e-3)) for t in times]
+    mx = sum(xs) / len(xs)
+    my = sum(ys) / len(ys)
+    sxx = sum((x - mx)**2 for x in xs)
+    sxy = sum((x - mx)*(y - my) for x, y in zip(xs, ys))
+    return sxy / sxx
+
+
+def benchmark_axis(axis, sizes, args):
+    """
+    Returns {"sizes": [...], "phases": {phase: [ms per size]},
+    "exponents": {phase: k}} or {"error": ...}.
+    """
+    results = []
+    for n in sizes:
+        files = generate(axis, n)
+        try:
+            runs = [compile_once(files, args) for _ in range(args.repeat)]
+        except RuntimeError as e:
+            return {"error": f"size {n}: {e}"}
+        # The minimum over the runs is the least noisy estimate
+        results.append({phase: min(r.get(phase, 0.0) for r in runs)
+            for phase in runs[0]})
+    phases = {}
+    for phase in results[-1]:
+        phases[phase] = [r.get(phase, 0.0) for r in results]
+    exponents = {}
+    for phase, times in phases.items():
+        if times[-1] >= MIN_TIME and len(sizes) > 1:
+            exponents[phase] = scaling_exponent(sizes, times)
+    return {"sizes": sizes, "phases": phases, "exponents": exponents}
+
+
+def print_axis(axis, r, max_exponent):
+    if "error" in r:
+        print(f"{axis}: compilation failed at {r['error']}\n")
+        return
+    header = f"{axis:28}" + "".join(f"{n:>10}" for n in r["sizes"])
+    print(header + f"{'exponent':>10}")
+    for phase, times in r["phases"].items():
+        line = f"  {phase:26}" + "".join(f"{t:10.1f}" for t in times)
+        k = r["exponents"].get(phase)
+        if k is not None:
+            line += f"{k:10.2f}"
+            if k > max_exponent:
+                line += "  <-- super-linear"
+        print(line)
+    print()
+
+
+def plot(results, filename):
+    try:
+        import matplotlib
+        matplotlib.use("Agg")
+        import matplotlib.pyplot as plt
+    except ImportError:
+        print("matplotlib is not available, skipping the plot")
+        return
+    axes = [a for a, r in results.items() if "error" not in r]
+    if not axes:
+        return
+    fig, plots = plt.subplots(len(axes), 1, figsize=(8, 4*len(axes)),
+            squeeze=False)
+    for ax, axis in zip(plots[:, 0], axes):
+        r = results[axis]
+        for phase, times in r["phases"].items():
+            if phase in r["exponents"] and not phase.startswith("pass "):
+                ax.loglog(r["sizes"], times, marker="o",
+                    label=f"{phase} (k={r['exponents'][phase]:.2f})")
+        ax.set_title(axis)
+        ax.set_xlabel("size")
+        ax.set_ylabel("time [ms]")
+        ax.legend(fontsize="small")
+    fig.tight_layout()
+    fig.savefig(filename)
+    print(f"Plot written to {filename}")
+
+
+def get_args():
+    parser = argparse.ArgumentParser(
+            description="LPython Compile Time Scalability Benchmarks")
+    parser.add_argument("-a", "--axes", nargs="*", default=list(AXES),
+            type=str, help="Benchmark the given axes (%s)" % \
+                    ", ".join(AXES))
+    parser.add_argument("--scale", type=float, default=1.0,
+            help="Multiply all the sizes by this factor (default: 1)")
+    parser.add_argument("-r", "--repeat", type=int, default=1,
+            help="Compile every program this many times (default: 1)")
+    parser.add_argument("-b", "--backend", type=str, default="llvm",
+            help="The backend to compile with (default: llvm)")
+    parser.add_argument("--fast", action="store_true",
+            help="Compile with --fast")
+    parser.add_argument("--max-exponent", type=float, default=1.3,
+            help="Fail if a phase scales worse than size**k for this k "
+            "(default: 1.3)")
+    parser.add_argument("-o", "--output", type=str,
+            help="Write the results to the given JSON file")
+    parser.add_argument("--plot", type=str,
+            help="Plot the scaling curves to the given file (needs "
+            "matplotlib)")
+    parser.add_argument("--lpython", type=str,
+            default=shutil.which("lpython", path=LPYTHON_PATH)
+                or shutil.which("lpython"),
+            help="The lpython executable to benchmark")
+    return parser.parse_args()
+
+
+def main():
+    args = get_args()
+    if args.lpython is None:
+        print("lpython executable not found, use --lpython")
+        return 1
+    args.lpython = os.path.realpath(args.lpython)
+
+    results = {}
+    failed = []
+    for axis in args.axes:
+        if axis not in AXES:
+            print(f"Unsupported axis: {axis}\n")
+            continue
+        sizes = [max(1, int(n * args.scale)) for n in DEFAULT_SIZES[axis]]
+        r = benchmark_axis(axis, sizes, args)
+        results[axis] = r
+        print_axis(axis, r, args.max_exponent)
+        if "error" in r:
+            failed.append(f"{axis} (compilation failed)")
+        else:
+            failed += [f"{axis}: {phase} (k={k:.2f})"
+                for phase, k in r["exponents"].items()
+                if k > args.max_exponent]
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(results, f, indent=4)
+            f.write("\n")
+    if args.plot:
+        plot(results, args.plot)
+
+    if failed:
+        print("Failed:")
+        for f in failed:
+            print(f"    {f}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,35 @@
+from ltypes import i32, i64
+
+def list_churn(n: i32) -> i64:
+    x: list[i32] = []
+    i: i32
+    r: i32
+    s: i64
+    s = i64(0)
+    for r in range(200):
+        for i in range(n):
+            x.append((i*7 + r) % 1000)
+        for i in range(n):
+            s += i64(x[i])
+        x.clear()
+    return s
+
+def dict_churn(n: i32) -> i64:
+    d: dict[i32, i32] = {}
+    i: i32
+    r: i32
+    s: i64
+    s = i64(0)
+    for i in range(n):
+        d[i] = i
+    for r in range(100):
+        for i in range(n):
+            d[i] = d[(i*31 + r) % n] + 1
+        s += i64(d[r])
+    return s
+
+def main():
+    print(list_churn(100000))
+    print(dict_churn(50000))
+
+main()
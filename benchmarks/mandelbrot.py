@@ -0,0 +1,35 @@
+from ltypes import i32, f64
+
+def mandelbrot(n: i32, max_iter: i32) -> i32:
+    # Number of points of an n x n grid over [-2, 1] x [-1.5, 1.5] that
+    # stay bounded for `max_iter` iterations
+    i: i32
+    j: i32
+    k: i32
+    inside: i32
+    cr: f64
+    ci: f64
+    zr: f64
+    zi: f64
+    t: f64
+    inside = 0
+    for i in range(n):
+        ci = 3.0*f64(i)/f64(n) - 1.5
+        for j in range(n):
+            cr = 3.0*f64(j)/f64(n) - 2.0
+            zr = 0.0
+            zi = 0.0
+            k = 0
+            while k < max_iter and zr*zr + zi*zi <= 4.0:
+                t = zr*zr - zi*zi + cr
+                zi = 2.0*zr*zi + ci
+                zr = t
+                k += 1
+            if k == max_iter:
+                inside += 1
+    return inside
+
+def main():
+    print(mandelbrot(1000, 300))
+
+main()
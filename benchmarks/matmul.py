@@ -0,0 +1,30 @@
+from ltypes import i32, f64
+from numpy import empty
+
+def matmul(n: i32) -> f64:
+    a: f64[n, n] = empty((n, n))
+    b: f64[n, n] = empty((n, n))
+    c: f64[n, n] = empty((n, n))
+    i: i32
+    j: i32
+    k: i32
+    s: f64
+    for i in range(n):
+        for j in range(n):
+            a[i, j] = f64((i + 2*j) % 7) - 3.0
+            b[i, j] = f64((3*i + j) % 11) - 4.0
+            c[i, j] = 0.0
+    for i in range(n):
+        for k in range(n):
+            for j in range(n):
+                c[i, j] = c[i, j] + a[i, k]*b[k, j]
+    s = 0.0
+    for i in range(n):
+        for j in range(n):
+            s = s + c[i, j]*f64((i + 2*j) % 5)
+    return s
+
+def main():
+    print(matmul(300))
+
+main()
@@ -0,0 +1,84 @@
+from ltypes import i32, f64
+from numpy import empty
+
+def energy(n: i32, x: f64[:], y: f64[:], z: f64[:], vx: f64[:], vy: f64[:],
+        vz: f64[:], m: f64[:]) -> f64:
+    i: i32
+    j: i32
+    e: f64
+    dx: f64
+    dy: f64
+    dz: f64
+    e = 0.0
+    for i in range(n):
+        e += 0.5*m[i]*(vx[i]*vx[i] + vy[i]*vy[i] + vz[i]*vz[i])
+        for j in range(i + 1, n):
+            dx = x[i] - x[j]
+            dy = y[i] - y[j]
+            dz = z[i] - z[j]
+            e -= m[i]*m[j]/(dx*dx + dy*dy + dz*dz)**0.5
+    return e
+
+def advance(n: i32, steps: i32, dt: f64, x: f64[:], y: f64[:], z: f64[:],
+        vx: f64[:], vy: f64[:], vz: f64[:], m: f64[:]):
+    s: i32
+    i: i32
+    j: i32
+    dx: f64
+    dy: f64
+    dz: f64
+    d2: f64
+    mag: f64
+    for s in range(steps):
+        for i in range(n):
+            for j in range(i + 1, n):
+                dx = x[i] - x[j]
+                dy = y[i] - y[j]
+                dz = z[i] - z[j]
+                d2 = dx*dx + dy*dy + dz*dz
+                mag = dt/(d2*d2**0.5)
+                vx[i] -= dx*m[j]*mag
+                vy[i] -= dy*m[j]*mag
+                vz[i] -= dz*m[j]*mag
+                vx[j] += dx*m[i]*mag
+                vy[j] += dy*m[i]*mag
+                vz[j] += dz*m[i]*mag
+        for i in range(n):
+            x[i] += dt*vx[i]
+            y[i] += dt*vy[i]
+            z[i] += dt*vz[i]
+
+def main():
+    # A small cluster of bodies on perturbed circular orbits around a heavy
+    # central body
+    n: i32 = 32
+    x: f64[32] = empty(32)
+    y: f64[32] = empty(32)
+    z: f64[32] = empty(32)
+    vx: f64[32] = empty(32)
+    vy: f64[32] = empty(32)
+    vz: f64[32] = empty(32)
+    m: f64[32] = empty(32)
+    i: i32
+    r: f64
+    x[0] = 0.0
+    y[0] = 0.0
+    z[0] = 0.0
+    vx[0] = 0.0
+    vy[0] = 0.0
+    vz[0] = 0.0
+    m[0] = 1000.0
+    for i in range(1, n):
+        r = 10.0 + f64(i)
+        x[i] = r
+        y[i] = 0.1*f64(i % 3)
+        z[i] = 0.05*f64(i % 5)
+        vx[i] = 0.0
+        vy[i] = (1000.0/r)**0.5
+        vz[i] = 0.0
+        m[i] = 0.01*f64(i)
+    print(energy(n, x, y, z, vx, vy, vz, m))
+    advance(n, 20000, 0.001, x, y, z, vx, vy, vz, m)
+    print(energy(n, x, y, z, vx, vy, vz, m))
+
+main()
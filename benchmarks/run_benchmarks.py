@@ -0,0 +1,398 @@
+#!/usr/bin/env python
+
+"""
+Runtime benchmarks of the code generated by LPython.
+
+Every kernel in this directory is compiled with each of the requested
+backends and the executable is run a few times. For every run the wall time,
+the peak resident set size and (where `perf_event_open` is permitted) the
+number of user space instructions retired are recorded. The results can be
+written to a JSON file and compared against a previous one to detect local
+performance regressions:
+
+    python run_benchmarks.py -o base.json
+    # ... change the compiler, rebuild ...
+    python run_benchmarks.py -o new.json --compare base.json
+"""
+
+import argparse
+import ctypes
+import json
+import os
+import platform
+import re
+import shutil
+import statistics
+import subprocess
+import sys
+import time
+
+SUPPORTED_BACKENDS = ['llvm', 'c', 'cpp', 'x86', 'wasm_x64']
+BASE_DIR = os.path.dirname(os.path.realpath(__file__))
+ROOT_DIR = os.path.dirname(BASE_DIR)
+LPYTHON_PATH = f"{ROOT_DIR}/src/bin"
+RUNTIME_INCLUDE = f"{ROOT_DIR}/src/libasr/runtime"
+
+
+def get_kernels():
+    return sorted(f[:-3] for f in os.listdir(BASE_DIR)
+            if f.endswith(".py") and f != os.path.basename(__file__))
+
+
+# Instruction counting through perf_event_open(2). The counter is attached to
+# the benchmark process before it calls exec and is only enabled by the exec,
+# so that neither the Python fork nor the runner itself is counted.
+
+class PerfEventAttr(ctypes.Structure):
+    _fields_ = [
+        ("type", ctypes.c_uint32),
+        ("size", ctypes.c_uint32),
+        ("config", ctypes.c_uint64),
+        ("sample_period", ctypes.c_uint64),
+        ("sample_type", ctypes.c_uint64),
+        ("read_format", ctypes.c_uint64),
+        ("flags", ctypes.c_uint64),
+        ("wakeup_events", ctypes.c_uint32),
+        ("bp_type", ctypes.c_uint32),
+        ("config1", ctypes.c_uint64),
+        ("config2", ctypes.c_uint64),
+        ("branch_sample_type", ctypes.c_uint64),
+        ("sample_regs_user", ctypes.c_uint64),
+        ("sample_stack_user", ctypes.c_uint32),
+        ("clockid", ctypes.c_int32),
+        ("sample_regs_intr", ctypes.c_uint64),
+        ("aux_watermark", ctypes.c_uint32),
+        ("sample_max_stack", ctypes.c_uint16),
+        ("reserved_2", ctypes.c_uint16),
+    ]
+
+PERF_TYPE_HARDWARE = 0
+PERF_COUNT_HW_INSTRUCTIONS = 1
+PERF_FLAG_DISABLED = 1 << 0
+PERF_FLAG_INHERIT = 1 << 1
+PERF_FLAG_EXCLUDE_KERNEL = 1 << 5
+PERF_FLAG_EXCLUDE_HV = 1 << 6
+PERF_FLAG_ENABLE_ON_EXEC = 1 << 12
+PERF_EVENT_OPEN_SYSCALL = {"x86_64": 298, "aarch64": 241, "ppc64le": 319}
+
+
+def perf_open_instructions(pid):
+    """
+    Returns a file descriptor counting the instructions of `pid` (and its
+    children) once it calls exec, or None if the counter is not available.
+    """
+    nr = PERF_EVENT_OPEN_SYSCALL.get(platform.machine())
+    if nr is None or sys.platform != "linux":
+        return None
+    attr = PerfEventAttr()
+    attr.type = PERF_TYPE_HARDWARE
+    attr.size = ctypes.sizeof(PerfEventAttr)
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS
+    attr.flags = (PERF_FLAG_DISABLED | PERF_FLAG_INHERIT
+            | PERF_FLAG_EXCLUDE_KERNEL | PERF_FLAG_EXCLUDE_HV
+            | PERF_FLAG_ENABLE_ON_EXEC)
+    libc = ctypes.CDLL(None, use_errno=True)
+    libc.syscall.restype = ctypes.c_long
+    fd = libc.syscall(ctypes.c_long(nr), ctypes.byref(attr),
+            ctypes.c_int(pid), ctypes.c_int(-1), ctypes.c_int(-1),
+            ctypes.c_ulong(0))
+    if fd < 0:
+        return None
+    return fd
+
+
+def perf_read(fd):
+    if fd is None:
+        return None
+    data = os.read(fd, 8)
+    os.close(fd)
+    if len(data) != 8:
+        return None
+    return int.from_bytes(data, sys.byteorder)
+
+
+def run_once(exe, output_file):
+    """
+    Runs `exe` with its standard output redirected to `output_file` and
+    returns (exit status, wall time in seconds, peak RSS in KiB,
+    instructions or None).
+    """
+    r, w = os.pipe()
+    pid = os.fork()
+    if pid == 0:
+        # Wait until the parent has attached the counter, then exec
+        try:
+            os.close(w)
+            os.read(r, 1)
+            os.close(r)
+            fd = os.open(output_file,
+                    os.O_WRONLY | os.O_CREAT | os.O_TRUNC, 0o644)
+            os.dup2(fd, 1)
+            os.execv(exe, [exe])
+        finally:
+            os._exit(127)
+    os.close(r)
+    counter = perf_open_instructions(pid)
+    start = time.perf_counter()
+    os.write(w, b"x")
+    os.close(w)
+    _, status, rusage = os.wait4(pid, 0)
+    wall_time = time.perf_counter() - start
+    # `ru_maxrss` is in KiB on Linux and in bytes on macOS
+    max_rss = rusage.ru_maxrss
+    if sys.platform == "darwin":
+        max_rss //= 1024
+    return (os.waitstatus_to_exitcode(status), wall_time, max_rss,
+            perf_read(counter))
+
+
+def compile_kernel(kernel, backend, args, workdir):
+    """
+    Compiles the kernel with the given backend, returns the path to the
+    executable. Raises RuntimeError with the compiler output on failure.
+    """
+    src = f"{BASE_DIR}/{kernel}.py"
+    exe = f"{workdir}/{kernel}"
+    fast = ["--fast"] if args.fast else []
+    if backend in ["c", "cpp"]:
+        # Translate to C/C++ and compile it ourselves, the same way the
+        # integration tests do for the C backend
+        source_file = f"{workdir}/{kernel}.{backend}"
+        p = subprocess.run([args.lpython, f"--show-{backend}"] + fast
+                + [src], capture_output=True, text=True, cwd=workdir)
+        if p.returncode == 0:
+            with open(source_file, "w") as f:
+                f.write(p.stdout)
+            cmd = [args.cc if backend == "c" else args.cxx,
+                    "-O3" if args.fast else "-O0", source_file, "-o", exe]
+            if backend == "c":
+                runtime_dir = os.path.join(os.path.dirname(args.lpython),
+                        "..", "runtime")
+                cmd += [f"-I{RUNTIME_INCLUDE}", f"-L{runtime_dir}",
+                        "-llpython_runtime_static", "-lm"]
+            else:
+                kokkos_dir = os.environ.get("LFORTRAN_KOKKOS_DIR")
+                if kokkos_dir:
+                    cmd += [f"-I{kokkos_dir}/include",
+                            f"{kokkos_dir}/lib/libkokkoscontainers.a",
+                            f"{kokkos_dir}/lib/libkokkoscore.a", "-ldl"]
+            p = subprocess.run(cmd, capture_output=True, text=True,
+                    cwd=workdir)
+    else:
+        cmd = [args.lpython] + fast + [src, "-o", exe]
+        if backend != "llvm":
+            cmd += ["--backend", backend]
+        p = subprocess.run(cmd, capture_output=True, text=True, cwd=workdir)
+    if p.returncode != 0 or not os.path.exists(exe):
+        raise RuntimeError((p.stdout + p.stderr).strip()
+                or "compilation failed")
+    return exe
+
+
+def first_error(output):
+    output = re.sub(r"\x1b\[[0-9;]*m", "", output)
+    lines = [l.strip() for l in output.splitlines() if l.strip()]
+    for line in lines:
+        if "error" in line.lower() or "exception" in line.lower():
+            return line
+    return lines[-1]
+
+
+def benchmark(kernel, backend, args, workdir):
+    start = time.perf_counter()
+    try:
+        exe = compile_kernel(kernel, backend, args, workdir)
+    except RuntimeError as e:
+        return {"error": f"compilation failed: {first_error(str(e))}"}
+    result = {"compile_time": time.perf_counter() - start}
+    output_file = f"{workdir}/{kernel}.out"
+    wall_times = []
+    instructions = []
+    max_rss = 0
+    for _ in range(args.repeat):
+        status, wall_time, rss, insts = run_once(exe, output_file)
+        if status != 0:
+            return {"error": f"exited with status {status}"}
+        wall_times.append(wall_time)
+        max_rss = max(max_rss, rss)
+        if insts is not None:
+            instructions.append(insts)
+    with open(output_file) as f:
+        output = f.read()
+    result["wall_time"] = min(wall_times)
+    result["wall_time_median"] = statistics.median(wall_times)
+    result["max_rss_kb"] = max_rss
+    result["instructions"] = min(instructions) if instructions else None
+    result["output"] = output
+    return result
+
+
+def format_result(r):
+    if "error" in r:
+        return r["error"]
+    insts = r["instructions"]
+    insts = "-" if insts is None else f"{insts/1e6:.1f}M"
+    return (f"{r['wall_time']*1000:9.1f} ms {r['max_rss_kb']:8d} KiB "
+            f"{insts:>10} insts")
+
+
+def same_output(a, b, rtol=1e-8):
+    """
+    Compares the outputs of two backends. Numbers are compared with a
+    relative tolerance, because the backends print floating point numbers
+    with different formats.
+    """
+    a, b = a.split(), b.split()
+    if len(a) != len(b):
+        return False
+    for x, y in zip(a, b):
+        if x == y:
+            continue
+        try:
+            x, y = float(x), float(y)
+        except ValueError:
+            return False
+        if abs(x - y) > rtol * max(abs(x), abs(y)):
+            return False
+    return True
+
+
+def check_outputs(results):
+    """
+    All backends must print the same checksums for a kernel.
+    """
+    ok = True
+    for kernel, backends in results.items():
+        outputs = {b: r["output"] for b, r in backends.items()
+                if "output" in r}
+        if not outputs:
+            continue
+        first = next(iter(outputs))
+        for backend, output in outputs.items():
+            if not same_output(outputs[first], output):
+                print(f"Warning: the output of {kernel} differs between "
+                    f"the {first} and {backend} backends")
+                ok = False
+    return ok
+
+
+def compare(base, results, threshold):
+    """
+    Prints the change against the results in `base` and returns the list of
+    regressions above `threshold` percent. Instructions are compared when
+    both runs have them, since they are far less noisy than the wall time.
+    """
+    regressions = []
+    print()
+    print(f"{'kernel':12} {'backend':9} {'metric':13} {'base':>12} "
+        f"{'new':>12} {'change':>8}")
+    for kernel, backends in results.items():
+        for backend, r in backends.items():
+            b = base.get("results", {}).get(kernel, {}).get(backend)
+            if b is None or "error" in b or "error" in r:
+                continue
+            if b.get("instructions") and r.get("instructions"):
+                metric = "instructions"
+            else:
+                metric = "wall_time"
+            change = 100 * (r[metric] - b[metric]) / b[metric]
+            mark = ""
+            if change > threshold:
+                mark = "  <-- regression"
+                regressions.append((kernel, backend, metric, change))
+            print(f"{kernel:12} {backend:9} {metric:13} {b[metric]:12.6g} "
+                f"{r[metric]:12.6g} {change:+7.1f}%{mark}")
+    return regressions
+
+
+def get_version(lpython):
+    p = subprocess.run([lpython, "--version"], capture_output=True, text=True)
+    return p.stdout.splitlines()[0] if p.returncode == 0 else None
+
+
+def get_commit():
+    p = subprocess.run(["git", "rev-parse", "HEAD"], capture_output=True,
+            text=True, cwd=ROOT_DIR)
+    return p.stdout.strip() if p.returncode == 0 else None
+
+
+def get_args():
+    parser = argparse.ArgumentParser(
+            description="LPython Runtime Benchmark Suite")
+    parser.add_argument("-b", "--backends", nargs="*", default=["llvm", "c"],
+            type=str, help="Benchmark the requested backends (%s)" % \
+                    ", ".join(SUPPORTED_BACKENDS))
+    parser.add_argument("-k", "--kernels", nargs="*", default=get_kernels(),
+            type=str, help="Benchmark only the given kernels (%s)" % \
+                    ", ".join(get_kernels()))
+    parser.add_argument("-r", "--repeat", type=int, default=3,
+            help="Number of runs of every executable (default: 3)")
+    parser.add_argument("--no-fast", dest="fast", action="store_false",
+            help="Compile without --fast (and with -O0 for the C backend)")
+    parser.add_argument("-o", "--output", type=str,
+            help="Write the results to the given JSON file")
+    parser.add_argument("--compare", type=str,
+            help="Compare against the results in the given JSON file")
+    parser.add_argument("--threshold", type=float, default=5.0,
+            help="Regression threshold in percent (default: 5)")
+    parser.add_argument("--lpython", type=str,
+            default=shutil.which("lpython", path=LPYTHON_PATH)
+                or shutil.which("lpython"),
+            help="The lpython executable to benchmark")
+    parser.add_argument("--cc", type=str, default=os.environ.get("CC", "cc"),
+            help="C compiler for the C backend (default: $CC or cc)")
+    parser.add_argument("--cxx", type=str,
+            default=os.environ.get("CXX", "c++"),
+            help="C++ compiler for the C++ backend (default: $CXX or c++)")
+    return parser.parse_args()
+
+
+def main():
+    args = get_args()
+    if args.lpython is None:
+        print("lpython executable not found, use --lpython")
+        return 1
+    args.lpython = os.path.realpath(args.lpython)
+
+    results = {}
+    for backend in args.backends:
+        if backend not in SUPPORTED_BACKENDS:
+            print(f"Unsupported Backend: {backend}\n")
+            continue
+        workdir = f"{BASE_DIR}/_lpython-bench-{backend}"
+        shutil.rmtree(workdir, ignore_errors=True)
+        os.makedirs(workdir)
+        for kernel in args.kernels:
+            r = benchmark(kernel, backend, args, workdir)
+            results.setdefault(kernel, {})[backend] = r
+            print(f"{kernel:12} {backend:9} {format_result(r)}", flush=True)
+
+    outputs_ok = check_outputs(results)
+    data = {
+        "lpython": get_version(args.lpython),
+        "commit": get_commit(),
+        "date": time.strftime("%Y-%m-%dT%H:%M:%S"),
+        "machine": platform.machine(),
+        "system": platform.system(),
+        "fast": args.fast,
+        "repeat": args.repeat,
+        "results": results,
+    }
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(data, f, indent=4)
+            f.write("\n")
+
+    if args.compare:
+        with open(args.compare) as f:
+            base = json.load(f)
+        regressions = compare(base, results, args.threshold)
+        if regressions:
+            print(f"\n{len(regressions)} regression(s) above "
+                f"{args.threshold}%")
+            return 1
+    return 0 if outputs_ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
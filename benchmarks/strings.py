@@ -0,0 +1,29 @@
+from ltypes import i32
+
+def build(n: i32) -> i32:
+    # Grow a string one piece at a time and return a checksum of its length
+    # and a few characters
+    s: str
+    i: i32
+    c: i32
+    s = ""
+    for i in range(n):
+        if i % 3 == 0:
+            s += "ab"
+        else:
+            s += "c"
+    c = 0
+    for i in range(0, len(s), 97):
+        if s[i] == "a":
+            c += 1
+    return len(s) + c
+
+def main():
+    r: i32
+    t: i32
+    t = 0
+    for r in range(10):
+        t += build(4000 + r)
+    print(t)
+
+main()
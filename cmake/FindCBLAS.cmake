@@ -0,0 +1,12 @@
+find_path(CBLAS_INCLUDE_DIR cblas.h PATH_SUFFIXES openblas)
+find_library(CBLAS_LIBRARY NAMES cblas openblas blas)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(CBLAS DEFAULT_MSG CBLAS_INCLUDE_DIR
+    CBLAS_LIBRARY)
+
+add_library(p::cblas INTERFACE IMPORTED)
+set_property(TARGET p::cblas PROPERTY INTERFACE_INCLUDE_DIRECTORIES
+    ${CBLAS_INCLUDE_DIR})
+set_property(TARGET p::cblas PROPERTY INTERFACE_LINK_LIBRARIES
+    ${CBLAS_LIBRARY})
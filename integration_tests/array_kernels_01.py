@@ -0,0 +1,113 @@
+from ltypes import i32, f32, f64
+from numpy import empty
+
+def reductions():
+    x: f64[1000] = empty(1000)
+    y: f64[1000] = empty(1000)
+    xs: f32[100] = empty(100)
+    i: i32
+    n: i32
+    s: f64
+    d: f64
+    ss: f32
+
+    n = 1000
+    for i in range(n):
+        x[i] = f64(i + 1)
+        y[i] = 2.0
+
+    s = 0.0
+    for i in range(n):
+        s = s + x[i]
+    assert s == 500500.0
+
+    d = 1.0
+    for i in range(n):
+        d = d + x[i]*y[i]
+    assert d == 1001001.0
+
+    s = 0.0
+    for i in range(10, 20):
+        s = x[i] + s
+    assert s == 155.0
+
+    for i in range(100):
+        xs[i] = f32(0.5)
+    ss = f32(0.0)
+    for i in range(100):
+        ss = ss + xs[i]*xs[i]
+    assert ss == f32(25.0)
+
+def matmul(m: i32, n: i32, p: i32):
+    a: f64[m, p] = empty((m, p))
+    b: f64[p, n] = empty((p, n))
+    c: f64[m, n] = empty((m, n))
+    ct: f64[n, m] = empty((n, m))
+    i: i32
+    j: i32
+    k: i32
+    expected: f64
+    t: f64
+
+    for i in range(m):
+        for k in range(p):
+            a[i, k] = f64(i - k)
+    for k in range(p):
+        for j in range(n):
+            b[k, j] = f64(k + 2*j)
+    for i in range(m):
+        for j in range(n):
+            c[i, j] = 1.0
+
+    for i in range(m):
+        for j in range(n):
+            for k in range(p):
+                c[i, j] = c[i, j] + a[i, k]*b[k, j]
+
+    for i in range(m):
+        for j in range(n):
+            expected = 1.0
+            for k in range(p):
+                t = f64(i - k)*f64(k + 2*j)
+                expected = expected + t
+            assert c[i, j] == expected
+
+    for j in range(n):
+        for i in range(m):
+            ct[j, i] = c[i, j]
+
+    for i in range(m):
+        for j in range(n):
+            assert ct[j, i] == c[i, j]
+
+def matmul_f32():
+    a: f32[3, 4] = empty((3, 4))
+    b: f32[4, 2] = empty((4, 2))
+    c: f32[3, 2] = empty((3, 2))
+    i: i32
+    j: i32
+    k: i32
+
+    for i in range(3):
+        for k in range(4):
+            a[i, k] = f32(i + k)
+    for k in range(4):
+        for j in range(2):
+            b[k, j] = f32(j + 1)
+    for i in range(3):
+        for j in range(2):
+            c[i, j] = f32(0.0)
+
+    for k in range(4):
+        for i in range(3):
+            for j in range(2):
+                c[i, j] = c[i, j] + b[k, j]*a[i, k]
+
+    for i in range(3):
+        for j in range(2):
+            assert c[i, j] == f32((4*i + 6)*(j + 1))
+
+reductions()
+matmul(3, 4, 5)
+matmul(67, 61, 70)
+matmul_f32()
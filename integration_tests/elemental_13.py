@@ -0,0 +1,89 @@
+from ltypes import i32, f32, f64
+from numpy import empty, sin, cos, tan, exp, log, tanh
+
+def verify1d(array: f64[:], observed: f64[:], name: str, eps: f64):
+    i: i32
+    expected: f64
+    for i in range(256):
+        if name == "sin":
+            expected = sin(array[i])
+        elif name == "cos":
+            expected = cos(array[i])
+        elif name == "tan":
+            expected = tan(array[i])
+        elif name == "exp":
+            expected = exp(array[i])
+        elif name == "log":
+            expected = log(array[i])
+        else:
+            expected = tanh(array[i])
+        assert abs(observed[i] - expected) <= eps * max(abs(expected), 1.0)
+
+def verify1d_f32(array: f32[:], observed: f32[:], name: str, eps: f32):
+    i: i32
+    expected: f32
+    scale: f32
+    for i in range(256):
+        if name == "sin":
+            expected = sin(array[i])
+        elif name == "exp":
+            expected = exp(array[i])
+        else:
+            expected = log(array[i])
+        scale = abs(expected)
+        if scale < f32(1.0):
+            scale = f32(1.0)
+        assert abs(observed[i] - expected) <= eps * scale
+
+def elemental_whole_array():
+    array: f64[256] = empty(256)
+    positive: f64[256] = empty(256)
+    observed: f64[256] = empty(256)
+    i: i32
+    eps: f64
+    eps = 1e-14
+
+    for i in range(256):
+        array[i] = f64(i - 128)/8.0
+        positive[i] = f64(i + 1)/16.0
+
+    observed = sin(array)
+    verify1d(array, observed, "sin", eps)
+    observed = cos(array)
+    verify1d(array, observed, "cos", eps)
+    observed = tan(array)
+    verify1d(array, observed, "tan", 1e-13)
+    observed = exp(array)
+    verify1d(array, observed, "exp", eps)
+    observed = log(positive)
+    verify1d(positive, observed, "log", eps)
+    observed = tanh(array)
+    verify1d(array, observed, "tanh", eps)
+
+    # Large arguments are reduced by the C library
+    for i in range(256):
+        array[i] = f64(i)*1e6
+    observed = sin(array)
+    verify1d(array, observed, "sin", eps)
+
+def elemental_whole_array_f32():
+    array: f32[256] = empty(256)
+    positive: f32[256] = empty(256)
+    observed: f32[256] = empty(256)
+    i: i32
+    eps: f32
+    eps = f32(1e-6)
+
+    for i in range(256):
+        array[i] = f32(i - 128)/f32(8.0)
+        positive[i] = f32(i + 1)/f32(16.0)
+
+    observed = sin(array)
+    verify1d_f32(array, observed, "sin", eps)
+    observed = exp(array)
+    verify1d_f32(array, observed, "exp", eps)
+    observed = log(positive)
+    verify1d_f32(positive, observed, "log", eps)
+
+elemental_whole_array()
+elemental_whole_array_f32()
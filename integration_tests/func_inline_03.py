@@ -0,0 +1,35 @@
+from ltypes import i32
+
+def square(x: i32) -> i32:
+    return x*x
+
+def clamp(x: i32, lo: i32, hi: i32) -> i32:
+    if x < lo:
+        return lo
+    if x > hi:
+        return hi
+    return x
+
+def sum_squares(n: i32) -> i32:
+    s: i32 = 0
+    i: i32 = 0
+    while i < n:
+        s = s + square(i)
+        i += 1
+    return s
+
+def test_inline():
+    s: i32 = sum_squares(5)
+    print(s)
+    assert s == 30
+    i: i32
+    c: i32 = 0
+    for i in range(-3, 13):
+        if i % 2 == 0:
+            c = c + clamp(i, 0, 10)
+        else:
+            c = c - square(i)
+    print(c)
+    assert c == 40 - 296
+
+test_inline()
@@ -0,0 +1,32 @@
+from ltypes import TypeVar, i32, f64
+
+T = TypeVar('T')
+
+def first(x: T, y: T) -> T:
+    return x
+
+def first_list(x: list[T], y: list[T]) -> T:
+    return x[0]
+
+def test_reuse():
+    # Every call with the same types reuses the same instantiation
+    i: i32
+    s: f64
+    s = 0.0
+    for i in range(10):
+        assert first(i, 5) == i
+        s += first(1.5, 2.5)
+    assert abs(s - 15.0) < 1e-12
+    assert first(3, 4) == 3
+    assert first("a", "b") == "a"
+    assert first(2.5, 3.5) == 2.5
+
+def test_list():
+    a: list[i32] = [1, 2]
+    b: list[f64] = [1.5, 2.5]
+    assert first_list(a, a) == 1
+    assert first_list(b, b) == 1.5
+    assert first_list(a, [3]) == 1
+
+test_reuse()
+test_list()
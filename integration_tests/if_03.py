@@ -0,0 +1,132 @@
+from ltypes import i32, i64
+
+def dense(op: i32) -> i32:
+    if op == 0:
+        return 10
+    elif op == 1:
+        return 11
+    elif op == 2 or op == 3:
+        return 23
+    elif op == 4:
+        return 14
+    elif op == 6:
+        return 16
+    else:
+        return -1
+
+def dense_i64(op: i64) -> i64:
+    r: i64
+    if op == i64(-2):
+        r = i64(1)
+    elif op == i64(-1):
+        r = i64(2)
+    elif op == i64(0):
+        r = i64(3)
+    elif op == i64(1):
+        r = i64(4)
+    else:
+        r = i64(0)
+    return r
+
+def sparse(x: i32) -> i32:
+    if x == -50:
+        return 1
+    elif x == 7:
+        return 2
+    elif x == 100 or x == 3000:
+        return 3
+    elif x == 20000:
+        return 4
+    elif x == 123456:
+        return 5
+    return 0
+
+def first_match(x: i32, y: i32) -> i32:
+    # the second `x == 1` and the test of `y` start the default
+    if x == 1:
+        return 1
+    elif x == 2:
+        return 2
+    elif x == 3:
+        return 3
+    elif x == 4:
+        return 4
+    elif x == 1:
+        return 5
+    elif y == 5:
+        return 6
+    return 0
+
+def machine(n: i32) -> i32:
+    # the `break` stays a loop exit
+    state: i32 = 0
+    while True:
+        if state == 0:
+            n -= 1
+            state = 1
+        elif state == 1:
+            n = 2*n
+            state = 2
+        elif state == 2:
+            if n > 100:
+                state = 4
+            else:
+                state = 0
+        elif state == 4:
+            break
+    return n
+
+def skip(n: i32) -> i32:
+    i: i32 = 0
+    c: i32 = 0
+    k: i32
+    while i < n:
+        i += 1
+        k = i % 5
+        if k == 0:
+            continue
+        elif k == 1:
+            c += 1
+        elif k == 2:
+            c += 10
+        elif k == 3:
+            c += 100
+        else:
+            c += 1000
+    return c
+
+def test_dispatch():
+    i: i32
+    s: i32 = 0
+    for i in range(-2, 9):
+        s += dense(i)
+    assert s == 10 + 11 + 23 + 23 + 14 + 16 - 5
+    assert dense(2) == 23
+    assert dense(5) == -1
+
+    j: i64
+    t: i64 = i64(0)
+    for j in range(i64(-4), i64(4)):
+        t = t*i64(10) + dense_i64(j)
+    assert t == i64(123400)
+    assert dense_i64(i64(4294967296)) == i64(0)
+
+    assert sparse(-50) == 1
+    assert sparse(7) == 2
+    assert sparse(100) == 3
+    assert sparse(3000) == 3
+    assert sparse(20000) == 4
+    assert sparse(123456) == 5
+    assert sparse(8) == 0
+    assert sparse(-49) == 0
+    assert sparse(123457) == 0
+
+    assert first_match(1, 5) == 1
+    assert first_match(4, 0) == 4
+    assert first_match(7, 5) == 6
+    assert first_match(7, 4) == 0
+
+    assert machine(5) == 194
+    assert skip(10) == 2222
+
+test_dispatch()
@@ -0,0 +1,68 @@
+from ltypes import i32
+
+# Lists, tuples and dicts assigned from temporaries or returned from local
+# variables are moved instead of copied
+
+def make_list(n: i32) -> list[i32]:
+    r: list[i32] = []
+    i: i32
+    for i in range(n):
+        r.append(i)
+    return r
+
+def extend(x: list[i32], n: i32) -> list[i32]:
+    r: list[i32] = []
+    i: i32
+    for i in range(len(x)):
+        r.append(x[i])
+    for i in range(n):
+        r.append(len(x) + i)
+    return r
+
+def make_pair(a: i32) -> tuple[i32, i32]:
+    t: tuple[i32, i32]
+    t = (a, len(make_list(a)))
+    return t
+
+def last(x: list[i32]) -> i32:
+    x.append(-1)
+    return x[len(x) - 2]
+
+def test_moves():
+    x: list[i32]
+    y: list[i32]
+    i: i32
+    x = make_list(5)
+    assert len(x) == 5
+    for i in range(10):
+        x = extend(x, 2)
+    assert len(x) == 25
+    for i in range(25):
+        assert x[i] == i
+
+    # Every temporary is a new list
+    for i in range(3):
+        y = [i, i + 1]
+        x.append(y[0])
+    assert len(y) == 2
+    assert y[0] == 2
+    assert x[25] == 0 and x[27] == 2
+
+    # A temporary passed by value
+    assert last([1, 2, 3]) == 3
+    assert last(make_list(4)) == 3
+
+    p: tuple[i32, i32]
+    p = make_pair(3)
+    assert p[0] == 3
+    assert p[1] == 3
+
+    d: dict[i32, i32]
+    for i in range(3):
+        d = {0: i, 9: 81}
+        d[1] = i
+    assert d[0] == 2
+    assert d[9] == 81
+    assert len(d) == 3
+
+test_moves()
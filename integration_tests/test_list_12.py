@@ -0,0 +1,76 @@
+from ltypes import i32
+
+def sum_all(x: list[i32]) -> i32:
+    s: i32 = 0
+    i: i32
+    for i in range(len(x)):
+        s += x[i]
+    return s
+
+def pairwise(x: list[i32]) -> list[i32]:
+    y: list[i32] = []
+    i: i32
+    for i in range(1, len(x)):
+        y.append(x[i] - x[i - 1])
+    return y
+
+def sum_first(x: list[i32], n: i32) -> i32:
+    s: i32 = 0
+    i: i32
+    for i in range(n):
+        s += x[i]
+    return s
+
+def reverse_in_place(x: list[i32]):
+    n: i32 = len(x)
+    i: i32
+    tmp: i32
+    for i in range(n//2):
+        tmp = x[i]
+        x[i] = x[n - 1 - i]
+        x[n - 1 - i] = tmp
+
+def sum_backwards(x: list[i32]) -> i32:
+    s: i32 = 0
+    i: i32
+    for i in range(len(x) - 1, -1, -1):
+        s = 2*s + x[i]
+    return s
+
+def grow(x: list[i32], n: i32) -> i32:
+    s: i32 = 0
+    i: i32
+    for i in range(n):
+        s += x[i]
+        x.append(x[i])
+    assert len(x) == 2*n
+    assert x[2*n - 1] == x[n - 1]
+    return s
+
+def test_bounds():
+    x: list[i32] = []
+    i: i32
+    for i in range(10):
+        x.append(i*i)
+
+    assert sum_all(x) == 285
+    y: list[i32] = pairwise(x)
+    assert len(y) == 9
+    for i in range(len(y)):
+        assert y[i] == 2*i + 1
+
+    assert sum_first(x, 0) == 0
+    assert sum_first(x, 4) == 14
+    assert sum_first(x, 10) == 285
+
+    reverse_in_place(x)
+    assert x[0] == 81
+    assert x[9] == 0
+    reverse_in_place(x)
+    assert x[3] == 9
+
+    z: list[i32] = [1, 0, 1, 1]
+    assert sum_backwards(z) == 13
+    assert grow(x, 10) == 285
+
+test_bounds()
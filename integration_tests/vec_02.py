@@ -0,0 +1,75 @@
+from ltypes import i32, i64, f32, f64
+from numpy import empty
+
+def axpy(n: i32, a: f64, x: f64[:], y: f64[:]):
+    i: i32
+    for i in range(n):
+        y[i] = a*x[i] + y[i]
+
+def clip(n: i32, lo: f32, x: f32[:], y: f32[:]):
+    i: i32
+    for i in range(n):
+        if x[i] < lo:
+            y[i] = lo
+        else:
+            y[i] = x[i]
+
+def imax(n: i32, x: i32[:]) -> i32:
+    i: i32
+    m: i32
+    m = x[0]
+    for i in range(n):
+        if x[i] > m:
+            m = x[i]
+    return m
+
+def isum(n: i32, x: i32[:]) -> i64:
+    i: i32
+    s: i64
+    s = i64(0)
+    for i in range(n):
+        s = s + i64(x[i])
+    return s
+
+def count_positive(n: i32, x: f64[:]) -> i32:
+    i: i32
+    c: i32
+    c = 0
+    for i in range(n):
+        if x[i] > 0.0:
+            c = c + 1
+    return c
+
+def loop_vec():
+    # Not a multiple of the vector length, so that the remainder loop is
+    # needed as well
+    n: i32 = 1003
+    x: f64[1003] = empty(1003)
+    y: f64[1003] = empty(1003)
+    xs: f32[1003] = empty(1003)
+    ys: f32[1003] = empty(1003)
+    k: i32[1003] = empty(1003)
+    i: i32
+
+    for i in range(n):
+        x[i] = f64(i - 500)
+        y[i] = 1.0
+        xs[i] = f32(i) - f32(10.0)
+        k[i] = 3*i - 1000
+
+    axpy(n, 2.0, x, y)
+    for i in range(n):
+        assert y[i] == 2.0*f64(i - 500) + 1.0
+
+    clip(n, f32(0.0), xs, ys)
+    for i in range(n):
+        if i < 10:
+            assert ys[i] == f32(0.0)
+        else:
+            assert ys[i] == f32(i - 10)
+
+    assert imax(n, k) == 2006
+    assert isum(n, k) == i64(504509)
+    assert count_positive(n, x) == 502
+
+loop_vec()
@@ -0,0 +1,68 @@
+from ltypes import i32, i64, f32, f64
+from numpy import empty
+
+def loop_vec():
+    # Not a multiple of the number of lanes, so that the scalar loop is
+    # needed for the remaining iterations
+    n: i32 = 1003
+    x: f64[1003] = empty(1003)
+    y: f64[1003] = empty(1003)
+    xs: f32[1003] = empty(1003)
+    ys: f32[1003] = empty(1003)
+    k: i32[1003] = empty(1003)
+    kl: i64[1003] = empty(1003)
+    a: f64 = 2.0
+    lo: f32 = f32(0.0)
+    i: i32
+    s: i32
+    sl: i64
+    sf: f64
+    c: i32
+
+    for i in range(n):
+        k[i] = 3*i - 1000
+        xs[i] = f32(i) - f32(10.0)
+        x[i] = f64(i - 500)
+        y[i] = 1.0
+        kl[i] = i64(i)
+
+    # axpy
+    for i in range(n):
+        y[i] = a*x[i] + y[i]
+    for i in range(n):
+        assert y[i] == 2.0*f64(i - 500) + 1.0
+
+    # select
+    for i in range(n):
+        if xs[i] < lo:
+            ys[i] = lo
+        else:
+            ys[i] = xs[i]
+    for i in range(n):
+        if i < 10:
+            assert ys[i] == f32(0.0)
+        else:
+            assert ys[i] == f32(i - 10)
+
+    # reductions
+    s = 0
+    for i in range(n):
+        s = s + k[i]
+    assert s == 504509
+    sl = i64(1)
+    for i in range(n):
+        sl = kl[i]*i64(2) + sl
+    assert sl == i64(1005007)
+    sf = 0.0
+    for i in range(n):
+        sf = sf + x[i]
+    assert sf == 1003.0
+
+    # conditional scalar assignments are not vectorised
+    c = 0
+    for i in range(n):
+        if x[i] > 0.0:
+            c = c + 1
+    assert c == 502
+
+loop_vec()
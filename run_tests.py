@@ -30,7 +30,8 @@ def single_test(test, verbose, no_llvm, update_reference,
     pass_ = test.get("pass", None)
     optimization_passes = ["flip_sign", "div_to_mul", "fma", "sign_from_value",
                            "inline_function_calls", "loop_unroll",
-                           "dead_code_removal", "loop_vectorise", "print_list"]
+                           "dead_code_removal", "loop_vectorise", "print_list",
+                           "array_kernels"]
 
     if pass_ and (pass_ not in ["do_loops", "global_stmts"] and
                   pass_ not in optimization_passes):
@@ -1,5 +1,10 @@
 #include <chrono>
 #include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <filesystem>
+#include <atomic>
+#include <thread>
 #include <stdlib.h>
 #include <cstdlib>
 
@@ -24,6 +29,7 @@
 #include <libasr/asr_utils.h>
 #include <libasr/asr_verify.h>
 #include <libasr/modfile.h>
+#include <libasr/serialization.h>
 #include <libasr/config.h>
 #include <libasr/string_utils.h>
 #include <libasr/lsp_interface.h>
@@ -191,7 +197,14 @@ int emit_asr(const std::string &infile,
     LCompilers::PassOptions pass_options;
     pass_options.run_fun = "f";
     pass_options.always_run = true;
+    pass_options.inline_threshold = compiler_options.inline_threshold;
+    pass_options.inline_budget = compiler_options.inline_budget;
+    if (compiler_options.remarks) {
+        pass_options.remarks = &diagnostics;
+    }
+    diagnostics.diagnostics.clear();
     pass_manager.apply_passes(al, asr, pass_options, diagnostics);
+    std::cerr << diagnostics.render(lm, compiler_options);
 
     if (compiler_options.tree) {
         std::cout << LFortran::pickle_tree(*asr, compiler_options.use_colors,
@@ -327,7 +340,7 @@ int emit_wat(const std::string &infile,
     LFortran::ASR::TranslationUnit_t* asr = r1.result;
 
     diagnostics.diagnostics.clear();
-    LFortran::Result<LFortran::Vec<uint8_t>> r2 = LFortran::asr_to_wasm_bytes_stream(*asr, al, diagnostics);
+    LFortran::Result<LFortran::Vec<uint8_t>> r2 = LFortran::asr_to_wasm_bytes_stream(*asr, al, diagnostics, compiler_options);
     std::cerr << diagnostics.render(lm, compiler_options);
     if (!r2.ok) {
         LFORTRAN_ASSERT(diagnostics.has_error())
@@ -558,8 +571,86 @@ void print_time_report(std::vector<std::pair<std::string, double>> &times, bool
     }
 }
 
+// Reports how much memory the compiler's allocator used
+void print_memory_report(const Allocator::Stats &stats, bool time_report) {
+    if (time_report) {
+        auto mb = [](size_t bytes) { return bytes / (1024.0 * 1024.0); };
+        std::cout << "Memory reserved: " << mb(stats.reserved) << "MB (peak "
+            << mb(stats.peak_reserved) << "MB)" << std::endl;
+        std::cout << "Memory used: " << mb(stats.used) << "MB" << std::endl;
+        std::cout << "Memory recycled: " << mb(stats.recycled)
+            << "MB (reused " << mb(stats.reused) << "MB, free "
+            << mb(stats.free) << "MB)" << std::endl;
+        std::cout << "Memory abandoned: " << mb(stats.lost) << "MB"
+            << std::endl;
+    }
+}
+
+// Appends the time of a backend `stage` that also applied the ASR passes:
+// the passes are reported first (in total and, indented, one by one),
+// followed by the rest of the stage
+void add_pass_times(std::vector<std::pair<std::string, double>> &times,
+    LCompilers::PassManager &pass_manager, const std::string &stage,
+    double stage_time) {
+    double passes_time = 0;
+    for (auto &pass: pass_manager.pass_times) {
+        passes_time += pass.second;
+    }
+    times.push_back(std::make_pair("ASR passes", passes_time));
+    for (auto &pass: pass_manager.pass_times) {
+        times.push_back(std::make_pair("    " + pass.first, pass.second));
+    }
+    times.push_back(std::make_pair(stage, stage_time - passes_time));
+    pass_manager.pass_times.clear();
+}
+
 #ifdef HAVE_LFORTRAN_LLVM
 
+// Returns the file name (inside `object_cache_dir`) of the object file
+// generated from `asr`. The key covers everything that influences the
+// emitted object: the compiler version, the target, the code generation
+// options, the ASR passes that will be applied and the full (pre-pass) ASR,
+// which includes all the modules it depends on.
+std::string get_cached_object_file(LFortran::ASR::TranslationUnit_t &asr,
+    LCompilers::PassManager& pass_manager, CompilerOptions &compiler_options,
+    const std::string &infile, bool main_module)
+{
+    std::string key = LFORTRAN_VERSION;
+    key += "\n" + ((compiler_options.target == "")
+        ? LFortran::LLVMEvaluator::get_default_target_triple()
+        : compiler_options.target);
+    key += "\n" + compiler_options.target_cpu;
+    key += "\n" + std::to_string(compiler_options.platform);
+    key += "\n" + infile;
+    key += "\n";
+    key += compiler_options.fast ? "f" : "-";
+    key += compiler_options.enable_bounds_checking ? "b" : "-";
+    key += compiler_options.emit_debug_info ? "g" : "-";
+    key += compiler_options.emit_debug_line_column ? "l" : "-";
+    key += compiler_options.openmp ? "o" : "-";
+    key += compiler_options.disable_main ? "d" : "-";
+    key += compiler_options.separate_compilation ? "s" : "-";
+    key += main_module ? "m" : "-";
+    key += compiler_options.profile_generate ? "p" : "-";
+    key += "\n" + std::to_string(compiler_options.inline_threshold)
+        + " " + std::to_string(compiler_options.inline_budget);
+    std::string profile;
+    if (!compiler_options.profile_use.empty()
+            && LFortran::read_file(compiler_options.profile_use, profile)) {
+        key += "\n" + profile;
+    }
+    for (auto &pass: pass_manager.get_passes()) {
+        key += "\n" + pass;
+    }
+    key += "\n" + LFortran::serialize(asr);
+
+    uint64_t h = LFortran::murmur_hash_str(key, 0);
+    h = (h << 32) | LFortran::murmur_hash_str(key, 0x9747b28c);
+    std::stringstream hex;
+    hex << std::setfill('0') << std::setw(16) << std::hex << h;
+    return compiler_options.object_cache_dir + "/" + hex.str() + ".o";
+}
+
 int emit_llvm(const std::string &infile,
     const std::string &runtime_library_dir,
     LCompilers::PassManager& pass_manager,
@@ -618,6 +709,7 @@ int compile_python_to_object_file(
         bool time_report, bool arg_c=false)
 {
     Allocator al(4*1024);
+    Allocator::Checkpoint al_start = al.checkpoint();
     LFortran::diag::Diagnostics diagnostics;
     LFortran::LocationManager lm;
     std::vector<std::pair<std::string, double>>times;
@@ -671,15 +763,35 @@ int compile_python_to_object_file(
     }
     diagnostics.diagnostics.clear();
 
+    // Object cache: reuse the object file if the ASR has not changed
+    std::string cached_object;
+    if (compiler_options.object_cache_dir != "") {
+        auto cache_lookup_start = std::chrono::high_resolution_clock::now();
+        cached_object = get_cached_object_file(*asr, pass_manager,
+            compiler_options, infile, !(arg_c && compiler_options.disable_main));
+        bool cache_hit = LFortran::path_exists(cached_object);
+        if (cache_hit) {
+            std::filesystem::copy_file(cached_object, outfile,
+                std::filesystem::copy_options::overwrite_existing);
+        }
+        auto cache_lookup_end = std::chrono::high_resolution_clock::now();
+        times.push_back(std::make_pair("Object cache lookup", std::chrono::duration<double, std::milli>(cache_lookup_end - cache_lookup_start).count()));
+        if (cache_hit) {
+            print_time_report(times, time_report);
+            return 0;
+        }
+    }
+
     // ASR -> LLVM
     LFortran::PythonCompiler fe(compiler_options);
-    LFortran::LLVMEvaluator e(compiler_options.target);
+    LFortran::LLVMEvaluator e(compiler_options.target, compiler_options.target_cpu);
     std::unique_ptr<LFortran::LLVMModule> m;
     auto asr_to_llvm_start = std::chrono::high_resolution_clock::now();
     LFortran::Result<std::unique_ptr<LFortran::LLVMModule>>
         res = fe.get_llvm3(*asr, pass_manager, diagnostics, infile);
     auto asr_to_llvm_end = std::chrono::high_resolution_clock::now();
-    times.push_back(std::make_pair("ASR to LLVM", std::chrono::duration<double, std::milli>(asr_to_llvm_end - asr_to_llvm_start).count()));
+    add_pass_times(times, pass_manager, "ASR to LLVM",
+        std::chrono::duration<double, std::milli>(asr_to_llvm_end - asr_to_llvm_start).count());
     std::cerr << diagnostics.render(lm, compiler_options);
     if (!res.ok) {
         LFORTRAN_ASSERT(diagnostics.has_error())
@@ -687,11 +799,27 @@ int compile_python_to_object_file(
         return 3;
     }
     m = std::move(res.result);
+    // The AST and ASR are not needed any more, give their memory back before
+    // LLVM generates the machine code
+    Allocator::Stats memory = al.stats();
+    al.rollback(al_start);
     auto llvm_start = std::chrono::high_resolution_clock::now();
     e.save_object_file(*(m->m_m), outfile);
     auto llvm_end = std::chrono::high_resolution_clock::now();
     times.push_back(std::make_pair("LLVM to binary", std::chrono::duration<double, std::milli>(llvm_end - llvm_start).count()));
+    if (cached_object != "") {
+        // Copy to a temporary file first and then rename it, so that
+        // concurrent compilations never see a partially written object
+        std::string tmp_object = cached_object + ".tmp"
+            + std::to_string(std::chrono::high_resolution_clock::now()
+                .time_since_epoch().count());
+        std::filesystem::create_directories(compiler_options.object_cache_dir);
+        std::filesystem::copy_file(outfile, tmp_object,
+            std::filesystem::copy_options::overwrite_existing);
+        std::filesystem::rename(tmp_object, cached_object);
+    }
     print_time_report(times, time_report);
+    print_memory_report(memory, time_report);
     return 0;
 }
 
@@ -763,11 +891,12 @@ int compile_to_binary_wasm(
 
     // ASR -> WASM
     auto asr_to_wasm_start = std::chrono::high_resolution_clock::now();
-    LFortran::Result<int> res = LFortran::asr_to_wasm(*asr, al,  outfile, time_report, diagnostics);
+    LFortran::Result<int> res = LFortran::asr_to_wasm(*asr, al,  outfile, time_report, diagnostics, compiler_options);
     auto asr_to_wasm_end = std::chrono::high_resolution_clock::now();
     times.push_back(std::make_pair("ASR to WASM", std::chrono::duration<double, std::milli>(asr_to_wasm_end - asr_to_wasm_start).count()));
     std::cerr << diagnostics.render(lm, compiler_options);
     print_time_report(times, time_report);
+    print_memory_report(al.stats(), time_report);
     if (!res.ok) {
         LFORTRAN_ASSERT(diagnostics.has_error())
         return 3;
@@ -841,6 +970,7 @@ int compile_to_binary_x86(
     times.push_back(std::make_pair("ASR to X86", std::chrono::duration<double, std::milli>(asr_to_x86_end - asr_to_x86_start).count()));
     std::cerr << diagnostics.render(lm, compiler_options);
     print_time_report(times, time_report);
+    print_memory_report(al.stats(), time_report);
     if (!r3.ok) {
         LFORTRAN_ASSERT(diagnostics.has_error())
         return 3;
@@ -910,7 +1040,8 @@ int compile_to_binary_wasm_to_x86(
 
     // ASR -> WASM
     auto asr_to_wasm_start = std::chrono::high_resolution_clock::now();
-    LFortran::Result<LFortran::Vec<uint8_t>> r3 = LFortran::asr_to_wasm_bytes_stream(*asr, al, diagnostics);
+    LFortran::Result<LFortran::Vec<uint8_t>> r3 = LFortran::asr_to_wasm_bytes_stream(*asr, al, diagnostics, compiler_options,
+        false /* br_table */);
     auto asr_to_wasm_end = std::chrono::high_resolution_clock::now();
     times.push_back(std::make_pair("ASR to WASM", std::chrono::duration<double, std::milli>(asr_to_wasm_end - asr_to_wasm_start).count()));
     std::cerr << diagnostics.render(lm, compiler_options);
@@ -939,6 +1070,7 @@ int compile_to_binary_wasm_to_x86(
 
     std::cerr << diagnostics.render(lm, compiler_options);
     print_time_report(times, time_report);
+    print_memory_report(al.stats(), time_report);
     if (!is_result_ok) {
         LFORTRAN_ASSERT(diagnostics.has_error())
         return 4;
@@ -1047,6 +1179,16 @@ int link_executable(const std::vector<std::string> &infiles,
             }
             cmd += + " -L"
                 + base_path + " -Wl,-rpath," + base_path + " -l" + runtime_lib + " -lm";
+            if (compiler_options.profile_generate) {
+                // Writes the counters of the instrumented code at exit
+                cmd += " -Wl,-u,__llvm_profile_runtime -llpython_instrprof";
+            }
+#ifdef LFORTRAN_CBLAS_LIBRARY
+            if (static_executable) {
+                // The shared runtime library brings in CBLAS by itself
+                cmd += " \"" + std::string(LFORTRAN_CBLAS_LIBRARY) + "\"";
+            }
+#endif
             int err = system(cmd.c_str());
             if (err) {
                 std::cout << "The command '" + cmd + "' failed." << std::endl;
@@ -1094,6 +1236,103 @@ int link_executable(const std::vector<std::string> &infiles,
     }
 }
 
+// Compiles every file in `files` as an independent program, with `n_jobs`
+// threads. Each program is compiled to an object file (`arg_c`) or an
+// executable named after its source file, and not run. Returns the number of
+// programs that failed to compile.
+int compile_files_concurrently(const std::vector<std::string> &files,
+        size_t n_jobs, Backend backend, bool arg_c, bool static_link,
+        const std::string &runtime_library_dir,
+        LCompilers::PassManager &pass_manager,
+        CompilerOptions &compiler_options, bool time_report)
+{
+    std::vector<std::string> outfiles;
+    std::set<std::string> unique_outfiles;
+    for (auto &file : files) {
+        if (!endswith(file, ".py")) {
+            std::cerr << "Only Python files can be compiled with -j: "
+                << file << std::endl;
+            return files.size();
+        }
+        std::string basename = remove_path(remove_extension(file));
+        outfiles.push_back(basename + (arg_c ? ".o" : ".out"));
+        if (!unique_outfiles.insert(outfiles.back()).second) {
+            std::cerr << "Two of the files would be compiled to "
+                << outfiles.back() << std::endl;
+            return files.size();
+        }
+    }
+
+    auto compile_one = [&](size_t i) -> int {
+        // Every compilation gets its own copy of the state it modifies
+        LFortran::ASRUtils::reset_compilation_state();
+        LCompilers::PassManager lpm = pass_manager;
+        CompilerOptions co = compiler_options;
+        const std::string &infile = files[i];
+        const std::string &outfile = outfiles[i];
+        if (backend == Backend::x86) {
+            return compile_to_binary_x86(infile, outfile,
+                runtime_library_dir, co, time_report);
+        } else if (backend == Backend::wasm) {
+            return compile_to_binary_wasm(infile, outfile,
+                runtime_library_dir, co, time_report);
+        } else if (backend == Backend::wasm_x86 || backend == Backend::wasm_x64) {
+            return compile_to_binary_wasm_to_x86(infile, outfile,
+                runtime_library_dir, co, time_report, backend);
+        } else if (backend == Backend::llvm) {
+#ifdef HAVE_LFORTRAN_LLVM
+            if (arg_c) {
+                return compile_python_to_object_file(infile, outfile,
+                    runtime_library_dir, lpm, co, time_report, arg_c);
+            }
+            std::string tmp_o = outfile + ".tmp.o";
+            int err = compile_python_to_object_file(infile, tmp_o,
+                runtime_library_dir, lpm, co, time_report);
+            if (err != 0) return err;
+            return link_executable({tmp_o}, outfile, runtime_library_dir,
+                backend, static_link, true, co);
+#else
+            std::cerr << "Compiling Python files to object files requires the LLVM backend to be enabled. Recompile with `WITH_LLVM=yes`." << std::endl;
+            return 1;
+#endif
+        } else {
+            std::cerr << "The -j option does not support this backend yet." << std::endl;
+            return 1;
+        }
+    };
+
+    std::atomic<size_t> next{0};
+    std::atomic<int> n_failed{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < files.size(); i = next++) {
+            int err;
+            try {
+                err = compile_one(i);
+            } catch (const LFortran::LCompilersException &e) {
+                std::cerr << "Internal Compiler Error: " + e.name() + ": "
+                    + e.msg() + "\n";
+                err = 1;
+            } catch (const std::exception &e) {
+                std::cerr << "std::exception: " + std::string(e.what()) + "\n";
+                err = 1;
+            }
+            if (err != 0) {
+                std::cerr << "Failed to compile " + files[i] + "\n";
+                n_failed++;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t j = 1; j < std::min(n_jobs, files.size()); j++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &t : threads) {
+        t.join();
+    }
+    return n_failed;
+}
+
 // int emit_c_preprocessor(const std::string &infile, CompilerOptions &compiler_options)
 // {
 //     std::string input = read_file(infile);
@@ -1177,7 +1416,7 @@ EMSCRIPTEN_KEEPALIVE char* emit_wat_from_source(char *input) {
         out = diagnostics.render(lm, compiler_options);
         if (asr.ok) {
             LFortran::Result<LFortran::Vec<uint8_t>>
-            wasm = LFortran::asr_to_wasm_bytes_stream(*asr.result, al, diagnostics);
+            wasm = LFortran::asr_to_wasm_bytes_stream(*asr.result, al, diagnostics, compiler_options);
             out = diagnostics.render(lm, compiler_options);
             if (wasm.ok) {
                 LFortran::Result<std::string>
@@ -1242,7 +1481,7 @@ EMSCRIPTEN_KEEPALIVE char* emit_wasm_from_source(char *input) {
         out = diagnostics.render(lm, compiler_options);
         if (asr.ok) {
             LFortran::Result<LFortran::Vec<uint8_t>>
-            wasm = LFortran::asr_to_wasm_bytes_stream(*asr.result, al, diagnostics);
+            wasm = LFortran::asr_to_wasm_bytes_stream(*asr.result, al, diagnostics, compiler_options);
             out = diagnostics.render(lm, compiler_options);
             if (wasm.ok) {
                 out = "0"; // exit code
@@ -1302,6 +1541,8 @@ int main(int argc, char *argv[])
         bool show_asm = false;
         bool show_wat = false;
         bool time_report = false;
+        bool no_pass_fusion = false;
+        size_t n_jobs = 0;
         bool static_link = false;
         std::string arg_backend = "llvm";
         std::string arg_kernel_f;
@@ -1328,6 +1569,7 @@ int main(int argc, char *argv[])
         // Standard options compatible with gfortran, gcc or clang
         // We follow the established conventions
         app.add_option("files", arg_files, "Source files");
+        app.add_option("-j,--jobs", n_jobs, "Compile every file as an independent program, with the given number of threads");
         // Should the following Options required for LPython??
         // Instead we need support all the options from Python 3
         app.add_flag("-S", arg_S, "Emit assembly, do not assemble or link");
@@ -1366,6 +1608,10 @@ int main(int argc, char *argv[])
         app.add_flag("--disable-main", compiler_options.disable_main, "Do not generate any code for the `main` function");
         app.add_flag("--symtab-only", compiler_options.symtab_only, "Only create symbol tables in ASR (skip executable stmt)");
         app.add_flag("--time-report", time_report, "Show compilation time report");
+        app.add_flag("--no-pass-fusion", no_pass_fusion, "Apply every ASR pass in its own traversal");
+        app.add_option("--object-cache", compiler_options.object_cache_dir, "Reuse object files stored in the given directory if the ASR has not changed");
+        app.add_flag("--separate-compilation", compiler_options.separate_compilation, "Only load the interface of modules imported from a `.pyc` file and link against their object files");
+        app.add_flag("--lazy-module-bodies", compiler_options.lazy_module_bodies, "Only lower the bodies of imported functions that are referenced");
         app.add_flag("--static", static_link, "Create a static executable");
         app.add_flag("--no-warnings", compiler_options.no_warnings, "Turn off all warnings");
         app.add_flag("--no-error-banner", compiler_options.no_error_banner, "Turn off error banner");
@@ -1373,7 +1619,13 @@ int main(int argc, char *argv[])
         app.add_flag("--enable-bounds-checking", compiler_options.enable_bounds_checking, "Turn on index bounds checking");
         app.add_flag("--openmp", compiler_options.openmp, "Enable openmp");
         app.add_flag("--fast", compiler_options.fast, "Best performance (disable strict standard compliance)");
+        app.add_option("--inline-threshold", compiler_options.inline_threshold, "Inline the calls whose cost is at most this (with --fast)")->capture_default_str();
+        app.add_option("--inline-budget", compiler_options.inline_budget, "Grow a function by at most this much by inlining (with --fast)")->capture_default_str();
+        app.add_flag("--remarks", compiler_options.remarks, "Report the inlining decisions as notes");
+        app.add_flag("--profile-generate", compiler_options.profile_generate, "Instrument the code to write an execution profile (LLVM backend)");
+        app.add_option("--profile-use", compiler_options.profile_use, "Optimize using the given profile, merged with `llvm-profdata merge` (LLVM backend)");
         app.add_option("--target", compiler_options.target, "Generate code for the given target")->capture_default_str();
+        app.add_option("--target-cpu", compiler_options.target_cpu, "Generate code for the given CPU (`native` for the host CPU)")->capture_default_str();
         app.add_flag("--print-targets", print_targets, "Print the registered targets");
         app.add_flag("--get-rtlib-header-dir", print_rtlib_header_dir, "Print the path to the runtime library header file");
 
@@ -1413,6 +1665,16 @@ int main(int argc, char *argv[])
         app.require_subcommand(0, 1);
         CLI11_PARSE(app, argc, argv);
 
+        if (compiler_options.profile_generate && !compiler_options.profile_use.empty()) {
+            std::cerr << "The options --profile-generate and --profile-use cannot be used together" << std::endl;
+            return 1;
+        }
+        if (!compiler_options.profile_use.empty()
+                && !std::filesystem::exists(compiler_options.profile_use)) {
+            std::cerr << "The profile '" << compiler_options.profile_use << "' does not exist" << std::endl;
+            return 1;
+        }
+
         if( compiler_options.fast && compiler_options.enable_bounds_checking ) {
         // ReleaseSafe Mode
         } else if ( compiler_options.fast ) {
@@ -1507,8 +1769,8 @@ int main(int argc, char *argv[])
             return 1;
         }
 
-        // TODO: for now we ignore the other filenames, only handle
-        // the first:
+        // The first file is compiled, the other filenames are only used
+        // when linking an executable with the LLVM backend:
         std::string arg_file = arg_files[0];
 
         std::string outfile;
@@ -1540,6 +1802,7 @@ int main(int argc, char *argv[])
         // }
 
         lpython_pass_manager.parse_pass_arg(arg_pass);
+        lpython_pass_manager.fuse_passes = !no_pass_fusion;
         if (show_tokens) {
             return emit_tokens(arg_file, true, compiler_options);
         }
@@ -1577,6 +1840,7 @@ int main(int argc, char *argv[])
 #endif
         }
         lpython_pass_manager.use_default_passes();
+        lpython_pass_manager.time_report = time_report;
         if (show_llvm) {
 #ifdef HAVE_LFORTRAN_LLVM
             return emit_llvm(arg_file, runtime_library_dir, lpython_pass_manager, compiler_options);
@@ -1601,6 +1865,16 @@ int main(int argc, char *argv[])
             }
         }
 
+        if (n_jobs > 0) {
+            if (compiler_options.arg_o != "") {
+                std::cerr << "The -o option cannot be used with -j." << std::endl;
+                return 1;
+            }
+            return compile_files_concurrently(arg_files, n_jobs, backend,
+                arg_c, static_link, runtime_library_dir, lpython_pass_manager,
+                compiler_options, time_report) == 0 ? 0 : 1;
+        }
+
         if (arg_c) {
             if (backend == Backend::llvm) {
 #ifdef HAVE_LFORTRAN_LLVM
@@ -1633,7 +1907,12 @@ int main(int argc, char *argv[])
                 err = compile_python_to_object_file(arg_file, tmp_o, runtime_library_dir,
                     lpython_pass_manager, compiler_options, time_report);
                 if (err != 0) return err;
-                err = link_executable({tmp_o}, outfile, runtime_library_dir,
+                // Any other files given (such as the object files of
+                // separately compiled modules) are linked in as well
+                std::vector<std::string> object_files = {tmp_o};
+                object_files.insert(object_files.end(),
+                    arg_files.begin() + 1, arg_files.end());
+                err = link_executable(object_files, outfile, runtime_library_dir,
                     backend, static_link, true, compiler_options);
                 if (err != 0) return err;
 #else
@@ -15,13 +15,75 @@ inline size_t align(size_t n) {
   return (n + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
 }
 
+// Blocks smaller than this are not worth recycling
+#define MIN_RECYCLED_SIZE 64
+#define NUM_SIZE_CLASSES (8*sizeof(size_t))
+
+// Returns floor(log2(n)) for n > 0
+inline size_t log2_floor(size_t n) {
+    size_t k = 0;
+    while (n >>= 1) k++;
+    return k;
+}
+
+// Returns ceil(log2(n)) for n > 0
+inline size_t log2_ceil(size_t n) {
+    size_t k = log2_floor(n);
+    return (n == ((size_t)1 << k)) ? k : k + 1;
+}
+
 class Allocator
 {
     void *start;
     size_t current_pos;
     size_t size;
     std::vector<void*> blocks;
+    std::vector<size_t> block_sizes;
+
+    // Blocks given back with `recycle()`, by size class: the list `k` holds
+    // blocks of at least 2^k bytes, linked through their first word
+    void *free_lists[NUM_SIZE_CLASSES];
+
+    // Statistics, see `stats()`. They are only updated when a chunk is
+    // allocated or a block recycled, never in `alloc()` itself.
+    size_t used_in_old_chunks;
+    size_t reserved;
+    size_t peak_reserved;
+    size_t recycled;
+    size_t reused;
+    size_t free_bytes;
+    size_t lost;
 public:
+    // Memory usage of the allocator, in bytes
+    struct Stats {
+        // Allocated from the system (all chunks)
+        size_t reserved;
+        // Highest value `reserved` ever reached (it only goes down in
+        // `rollback()`)
+        size_t peak_reserved;
+        // Handed out by `alloc()` (including blocks later recycled)
+        size_t used;
+        // Given back with `recycle()` and not reused yet
+        size_t free;
+        // Given back with `recycle()` in total, and how much of it was
+        // handed out again (blocks are counted by the lower bound of their
+        // size class)
+        size_t recycled;
+        size_t reused;
+        // Abandoned blocks that were too small to be recycled
+        size_t lost;
+    };
+
+    // The state of the allocator at some point, see `checkpoint()`
+    struct Checkpoint {
+        size_t num_blocks;
+        void *start;
+        size_t current_pos;
+        size_t size;
+        size_t used_in_old_chunks;
+        size_t reserved;
+    };
+
     Allocator(size_t s) {
         s += ALIGNMENT;
         start = malloc(s);
@@ -30,6 +92,15 @@ public:
         current_pos = align(current_pos);
         size = s;
         blocks.push_back(start);
+        block_sizes.push_back(s);
+        std::fill(free_lists, free_lists + NUM_SIZE_CLASSES, nullptr);
+        used_in_old_chunks = 0;
+        reserved = s;
+        peak_reserved = s;
+        recycled = 0;
+        reused = 0;
+        free_bytes = 0;
+        lost = 0;
     }
     Allocator() = delete;
     Allocator(const Allocator&) = delete;
@@ -65,8 +136,13 @@ public:
 
     void *new_chunk(size_t s) {
         size_t snew = std::max(s+ALIGNMENT, 2*size);
+        // `alloc()` has already advanced past the end of the chunk
+        used_in_old_chunks += size_current() - align(s);
+        reserved += snew;
+        peak_reserved = std::max(peak_reserved, reserved);
         start = malloc(snew);
         blocks.push_back(start);
+        block_sizes.push_back(snew);
         if (start == nullptr) {
             throw std::runtime_error("malloc failed.");
         }
@@ -87,6 +163,95 @@ public:
         return (T *)alloc(sizeof(T) * n);
     }
 
+    // Like `alloc()`, but first tries to reuse a block given back with
+    // `recycle()`. Used for buffers that grow (such as the ones of `Vec`),
+    // because they are the ones that get recycled.
+    void *alloc_reuse(size_t s) {
+        if (s >= MIN_RECYCLED_SIZE) {
+            size_t k = log2_ceil(s);
+            void *p = free_lists[k];
+            if (p != nullptr) {
+                free_lists[k] = *(void**)p;
+                reused += (size_t)1 << k;
+                free_bytes -= (size_t)1 << k;
+                return p;
+            }
+        }
+        return alloc(s);
+    }
+
+    template <typename T> T* allocate_reuse(size_t n=1) {
+        return (T *)alloc_reuse(sizeof(T) * n);
+    }
+
+    // Gives back the block `p` of `s` bytes, previously returned by `alloc()`
+    // or `alloc_reuse()`, so that `alloc_reuse()` can hand it out again. The
+    // caller must not use the block any more.
+    void recycle(void *p, size_t s) {
+        if (s < MIN_RECYCLED_SIZE) {
+            lost += s;
+            return;
+        }
+        if (!owns(p)) {
+            // Such as the memory of a `Vec::from_pointer_n()`
+            return;
+        }
+        size_t k = log2_floor(s);
+#ifdef WITH_LFORTRAN_ASSERT
+        // Catch uses of the block after it was recycled
+        std::fill((char*)p, (char*)p + s, (char)0xab);
+#endif
+        *(void**)p = free_lists[k];
+        free_lists[k] = p;
+        recycled += (size_t)1 << k;
+        free_bytes += (size_t)1 << k;
+    }
+
+    // Returns true if `p` points into one of the chunks of this allocator
+    bool owns(void *p) {
+        for (size_t i = 0; i < blocks.size(); i++) {
+            if ((size_t)p >= (size_t)blocks[i]
+                    && (size_t)p < (size_t)blocks[i] + block_sizes[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Returns the current state, everything allocated after it can be freed
+    // at once with `rollback()`. Useful for scratch data, such as the
+    // temporary vectors of a pass.
+    Checkpoint checkpoint() {
+        return {blocks.size(), start, current_pos, size, used_in_old_chunks,
+            reserved};
+    }
+
+    // Frees everything allocated after the checkpoint `c`. No memory
+    // allocated since then may be used any more, and checkpoints taken after
+    // `c` become invalid.
+    void rollback(const Checkpoint &c) {
+        LFORTRAN_ASSERT(c.num_blocks <= blocks.size());
+        for (size_t i = c.num_blocks; i < blocks.size(); i++) {
+            free(blocks[i]);
+        }
+        blocks.resize(c.num_blocks);
+        block_sizes.resize(c.num_blocks);
+        start = c.start;
+        current_pos = c.current_pos;
+        size = c.size;
+        used_in_old_chunks = c.used_in_old_chunks;
+        reserved = c.reserved;
+        // The free lists may contain blocks that were just freed or handed
+        // out, and it is not worth finding out which, so they are dropped
+        std::fill(free_lists, free_lists + NUM_SIZE_CLASSES, nullptr);
+        free_bytes = 0;
+    }
+
+    Stats stats() {
+        return {reserved, peak_reserved, used_in_old_chunks + size_current(),
+            free_bytes, recycled, reused, lost};
+    }
+
     // Just like `new`, but using Allocator
     // The following two examples both construct the same instance MyInt(5),
     // but first uses the default C++ allocator, while the second uses
@@ -115,4 +280,26 @@ public:
     }
 };
 
+// Frees all the memory allocated in `al` during the lifetime of the scope,
+// which must not be used once the scope is left:
+//
+//     {
+//         ScratchScope scratch(al);
+//         Vec<ASR::expr_t*> tmp;
+//         tmp.reserve(al, 16);
+//         ...
+//     } // `tmp` is freed here
+class ScratchScope
+{
+    Allocator &al;
+    Allocator::Checkpoint c;
+public:
+    ScratchScope(Allocator &al) : al{al}, c{al.checkpoint()} {}
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+    ~ScratchScope() {
+        al.rollback(c);
+    }
+};
+
 #endif
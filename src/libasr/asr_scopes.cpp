@@ -64,7 +64,8 @@ std::string hexify(T i)
     return buf.str();
 }
 
-unsigned int symbol_table_counter = 0;
+// Per thread, so that different threads can compile independently
+thread_local unsigned int symbol_table_counter = 0;
 
 SymbolTable::SymbolTable(SymbolTable *parent) : parent{parent} {
     symbol_table_counter++;
@@ -75,6 +76,55 @@ void SymbolTable::reset_global_counter() {
     symbol_table_counter = 0;
 }
 
+void SymbolTable::index_insert(scope_t::value_type *entry, uint32_t h) {
+    // Keep the load factor below 3/4
+    if (4 * (index_size + 1) > 3 * index.size()) {
+        std::vector<Slot> old(std::max<size_t>(8, 2 * index.size()), {0, nullptr});
+        old.swap(index);
+        size_t mask = index.size() - 1;
+        for (auto &slot : old) {
+            if (!slot.entry) continue;
+            size_t i = slot.hash & mask;
+            while (index[i].entry) i = (i + 1) & mask;
+            index[i] = slot;
+        }
+    }
+    size_t mask = index.size() - 1;
+    size_t i = h & mask;
+    while (index[i].entry) i = (i + 1) & mask;
+    index[i] = {h, entry};
+    index_size++;
+}
+
+void SymbolTable::index_erase(const std::string &name, uint32_t h) {
+    if (index.empty()) return;
+    size_t mask = index.size() - 1;
+    size_t i = h & mask;
+    while (index[i].entry &&
+            (index[i].hash != h || index[i].entry->first != name)) {
+        i = (i + 1) & mask;
+    }
+    if (!index[i].entry) return;
+    // Backward shift deletion: move every following slot of the probe
+    // sequence that can be moved into the hole, so that no tombstones are
+    // needed
+    size_t j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        if (!index[j].entry) break;
+        size_t home = index[j].hash & mask;
+        // The slot `j` can move to `i` unless its home lies in (i, j]
+        bool in_between = (i <= j) ? (i < home && home <= j)
+                                   : (i < home || home <= j);
+        if (!in_between) {
+            index[i] = index[j];
+            i = j;
+        }
+    }
+    index[i] = {0, nullptr};
+    index_size--;
+}
+
 void SymbolTable::mark_all_variables_external(Allocator &/*al*/) {
     for (auto &a : scope) {
         switch (a.second->type) {
@@ -100,8 +150,8 @@ ASR::symbol_t *SymbolTable::find_scoped_symbol(const std::string &name,
     const SymbolTable *s = this;
     for(size_t i=0; i < n_scope_names; i++) {
         std::string scope_name = m_scope_names[i];
-        if (s->scope.find(scope_name) != scope.end()) {
-            ASR::symbol_t *sym = s->scope.at(scope_name);
+        ASR::symbol_t *sym = s->get_symbol(scope_name);
+        if (sym) {
             s = ASRUtils::symbol_symtab(sym);
             if (s == nullptr) {
                 // The m_scope_names[i] found in the appropriate symbol table,
@@ -114,20 +164,15 @@ ASR::symbol_t *SymbolTable::find_scoped_symbol(const std::string &name,
             return nullptr;
         }
     }
-    if (s->scope.find(name) != scope.end()) {
-        ASR::symbol_t *sym = s->scope.at(name);
-        LFORTRAN_ASSERT(sym)
-        return sym;
-    } else {
-        // The `name` not found in the appropriate symbol table
-        return nullptr;
-    }
+    // Returns `nullptr` if the `name` is not found in the appropriate symbol
+    // table
+    return s->get_symbol(name);
 }
 
 std::string SymbolTable::get_unique_name(const std::string &name) {
     std::string unique_name = name;
     int counter = 1;
-    while (scope.find(unique_name) != scope.end()) {
+    while (get_symbol(unique_name) != nullptr) {
         unique_name = name + std::to_string(counter);
         counter++;
     }
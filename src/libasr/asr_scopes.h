@@ -2,6 +2,7 @@
 #define LFORTRAN_SEMANTICS_ASR_SCOPES_H
 
 #include <map>
+#include <vector>
 
 #include <libasr/alloc.h>
 
@@ -12,9 +13,49 @@ namespace ASR {
     struct symbol_t;
 }
 
+// Stable (platform and run independent) hashes of the given content
+uint32_t murmur_hash_str(const std::string &s, uint32_t seed);
+uint32_t murmur_hash_int(uint64_t i, uint32_t seed);
+
 struct SymbolTable {
     private:
-    std::map<std::string, ASR::symbol_t*> scope;
+    typedef std::map<std::string, ASR::symbol_t*> scope_t;
+    // Owns the names and gives the deterministic (sorted) iteration order
+    scope_t scope;
+
+    // Open addressing (linear probing) hash index over `scope`, used for all
+    // lookups. The slots point to the entries of `scope` (which are stable),
+    // so every name is stored only once. The capacity is zero or a power of
+    // two.
+    struct Slot {
+        uint32_t hash;
+        scope_t::value_type *entry; // nullptr for an empty slot
+    };
+    std::vector<Slot> index;
+    size_t index_size = 0;
+
+    static uint32_t hash_name(const std::string &name) {
+        // FNV-1a, names are short
+        uint32_t h = 2166136261u;
+        for (char c : name) {
+            h = (h ^ (unsigned char)c) * 16777619u;
+        }
+        return h;
+    }
+
+    scope_t::value_type *find_entry(const std::string &name, uint32_t h) const {
+        if (index.empty()) return nullptr;
+        size_t mask = index.size() - 1;
+        for (size_t i = h & mask; index[i].entry; i = (i + 1) & mask) {
+            if (index[i].hash == h && index[i].entry->first == name) {
+                return index[i].entry;
+            }
+        }
+        return nullptr;
+    }
+
+    void index_insert(scope_t::value_type *entry, uint32_t h);
+    void index_erase(const std::string &name, uint32_t h);
 
     public:
     SymbolTable *parent;
@@ -26,25 +67,26 @@ struct SymbolTable {
     unsigned int counter;
 
     SymbolTable(SymbolTable *parent);
+    // The index points into `scope`, a copy would point into the original
+    SymbolTable(const SymbolTable &) = delete;
+    SymbolTable &operator=(const SymbolTable &) = delete;
 
     // Determines a stable hash based on the content of the symbol table
     uint32_t get_hash_uint32(); // Returns the hash as an integer
     std::string get_counter() {  // Returns a unique ID as a string
         return std::to_string(counter);
     }
-    static void reset_global_counter(); // Resets the internal global counter
+    static void reset_global_counter(); // Resets the internal (per thread) counter
 
     // Resolves the symbol `name` recursively in current and parent scopes.
     // Returns `nullptr` if symbol not found.
-    ASR::symbol_t* resolve_symbol(const std::string &name) {
-        if (scope.find(name) == scope.end()) {
-            if (parent) {
-                return parent->resolve_symbol(name);
-            } else {
-                return nullptr;
-            }
+    ASR::symbol_t* resolve_symbol(const std::string &name) const {
+        uint32_t h = hash_name(name);
+        for (const SymbolTable *s = this; s; s = s->parent) {
+            scope_t::value_type *entry = s->find_entry(name, h);
+            if (entry) return entry->second;
         }
-        return scope[name];
+        return nullptr;
     }
 
     const std::map<std::string, ASR::symbol_t*>& get_scope() const {
@@ -54,23 +96,24 @@ struct SymbolTable {
     // Obtains the symbol `name` from the current symbol table
     // Returns `nullptr` if symbol not found.
     ASR::symbol_t* get_symbol(const std::string &name) const {
-        //auto it = scope.find(to_lower(name));
-        auto it = scope.find(name);
-        if (it == scope.end()) {
-            return nullptr;
-        } else {
-            return it->second;
-        }
+        scope_t::value_type *entry = find_entry(name, hash_name(name));
+        return entry ? entry->second : nullptr;
     }
 
     void erase_symbol(const std::string &name) {
-        //auto it = scope.find(to_lower(name));
         LFORTRAN_ASSERT(scope.find(name) != scope.end())
+        index_erase(name, hash_name(name));
         scope.erase(name);
     }
 
     void add_symbol(const std::string &name, ASR::symbol_t* symbol) {
-        scope[name] = symbol;
+        uint32_t h = hash_name(name);
+        scope_t::value_type *entry = find_entry(name, h);
+        if (entry) {
+            entry->second = symbol;
+        } else {
+            index_insert(&*scope.emplace(name, symbol).first, h);
+        }
     }
 
     // Marks all variables as external
@@ -975,7 +975,7 @@ ASR::asr_t* make_Cast_t_value(Allocator &al, const Location &a_loc,
 }
 
 //Initialize pointer to zero so that it can be initialized in first call to get_instance
-ASRUtils::LabelGenerator* ASRUtils::LabelGenerator::label_generator = nullptr;
+thread_local ASRUtils::LabelGenerator* ASRUtils::LabelGenerator::label_generator = nullptr;
 
 } // namespace ASRUtils
 
@@ -2050,11 +2050,13 @@ class ReplaceReturnWithGotoVisitor: public ASR::BaseStmtReplacer<ReplaceReturnWi
 // Singleton LabelGenerator so that it generates
 // unique labels for different statements, from
 // whereever it is called (be it ASR passes, be it
-// AST to ASR transition, etc).
+// AST to ASR transition, etc). There is one instance
+// per thread, so that different threads can compile
+// independently.
 class LabelGenerator {
     private:
 
-        static LabelGenerator *label_generator;
+        static thread_local LabelGenerator *label_generator;
         uint64_t unique_label;
         std::map<ASR::asr_t*, uint64_t> node2label;
 
@@ -2087,8 +2089,22 @@ class LabelGenerator {
         bool verify(ASR::asr_t* node) {
             return node2label.find(node) != node2label.end();
         }
+
+        void reset() {
+            unique_label = 0;
+            node2label.clear();
+        }
 };
 
+// Resets the per thread state that is kept across compilations (the symbol
+// table counter and the labels), so that a program compiles to the same
+// result no matter what was compiled before it on the same thread. Must not
+// be called while an ASR of a previous compilation is still in use.
+static inline void reset_compilation_state() {
+    SymbolTable::reset_global_counter();
+    LabelGenerator::get_instance()->reset();
+}
+
 ASR::asr_t* make_Cast_t_value(Allocator &al, const Location &a_loc,
         ASR::expr_t* a_arg, ASR::cast_kindType a_kind, ASR::ttype_t* a_type);
 
@@ -47,7 +47,7 @@ private:
     // points to them (i.e., that nothing points to some symbol table that
     // is not part of this ASR).
     std::map<uint64_t,SymbolTable*> id_symtab_map;
-    std::vector<std::string> function_dependencies;
+    std::set<std::string> function_dependencies;
     std::vector<std::string> module_dependencies;
     std::vector<std::string> variable_dependencies;
 
@@ -267,7 +267,6 @@ public:
 
     void visit_Function(const Function_t &x) {
         function_dependencies.clear();
-        function_dependencies.reserve(x.n_dependencies);
         SymbolTable *parent_symtab = current_symtab;
         current_symtab = x.m_symtab;
         require(x.m_symtab != nullptr,
@@ -295,17 +294,19 @@ public:
         }
         // Check if there are unnecessary dependencies
         // present in the dependency list of the function
+        std::set<std::string> listed_dependencies;
         for( size_t i = 0; i < x.n_dependencies; i++ ) {
             std::string found_dep = x.m_dependencies[i];
-            require(std::find(function_dependencies.begin(), function_dependencies.end(), found_dep) != function_dependencies.end(),
+            require(function_dependencies.find(found_dep) != function_dependencies.end(),
                     "Function " + std::string(x.m_name) + " doesn't depend on " + found_dep +
                     " but is found in its dependency list.");
+            listed_dependencies.insert(found_dep);
         }
 
         // Check if all the dependencies found are
         // present in the dependency list of the function
         for( auto& found_dep: function_dependencies ) {
-            require(present(x.m_dependencies, x.n_dependencies, found_dep),
+            require(listed_dependencies.find(found_dep) != listed_dependencies.end(),
                     "Function " + std::string(x.m_name) + " depends on " + found_dep +
                     " but isn't found in its dependency list.");
         }
@@ -597,7 +598,7 @@ public:
                     "SubroutineCall::m_name '" + std::string(symbol_name(x.m_name)) + "' must be a Function");
             }
         }
-        function_dependencies.push_back(std::string(ASRUtils::symbol_name(x.m_name)));
+        function_dependencies.insert(std::string(ASRUtils::symbol_name(x.m_name)));
         if( ASR::is_a<ASR::ExternalSymbol_t>(*x.m_name) ) {
             ASR::ExternalSymbol_t* x_m_name = ASR::down_cast<ASR::ExternalSymbol_t>(x.m_name);
             module_dependencies.push_back(std::string(x_m_name->m_module_name));
@@ -695,7 +696,7 @@ public:
     void visit_FunctionCall(const FunctionCall_t &x) {
         require(x.m_name,
             "FunctionCall::m_name must be present");
-        function_dependencies.push_back(std::string(ASRUtils::symbol_name(x.m_name)));
+        function_dependencies.insert(std::string(ASRUtils::symbol_name(x.m_name)));
         if( ASR::is_a<ASR::ExternalSymbol_t>(*x.m_name) ) {
             ASR::ExternalSymbol_t* x_m_name = ASR::down_cast<ASR::ExternalSymbol_t>(x.m_name);
             module_dependencies.push_back(std::string(x_m_name->m_module_name));
@@ -13,6 +13,7 @@
 #include <libasr/pass/class_constructor.h>
 #include <libasr/pass/array_op.h>
 #include <libasr/pass/subroutine_from_function.h>
+#include <libasr/pass/select_case.h>
 
 #include <map>
 #include <utility>
@@ -1208,6 +1209,8 @@ Result<std::string> asr_to_c(Allocator &al, ASR::TranslationUnit_t &asr,
     pass_options.always_run = true;
     pass_create_subroutine_from_function(al, asr, pass_options);
     pass_replace_array_op(al, asr, pass_options);
+    pass_options.native_switch = true;
+    pass_replace_select_case(al, asr, pass_options);
     pass_unused_functions(al, asr, pass_options);
     pass_replace_class_constructor(al, asr, pass_options);
     ASRToCVisitor v(diagnostics, platform, default_lower_bound);
@@ -1574,10 +1574,71 @@ R"(#include <stdio.h>
         src = out;
     }
 
-    void visit_Select(const ASR::Select_t &/*x*/) {
+    // Returns the constant integer value of the case test `x`
+    int64_t get_case_value(ASR::expr_t *x) {
+        ASR::expr_t *value = ASRUtils::expr_value(x);
+        if (value == nullptr || !ASR::is_a<ASR::IntegerConstant_t>(*value)) {
+            throw CodeGenError("Only constant integer cases are supported in a select",
+                x->base.loc);
+        }
+        return ASR::down_cast<ASR::IntegerConstant_t>(value)->m_n;
+    }
+
+    // The `select_case` pass keeps the selects with dense constant cases
+    // (`PassOptions::native_switch`), they are emitted as a `switch`
+    void visit_Select(const ASR::Select_t &x) {
+        std::string current_body_copy = current_body;
         std::string indent(indentation_level*indentation_spaces, ' ');
-        std::string out = indent + "// FIXME: select case()\n";
+        std::string case_indent = indent + std::string(indentation_spaces, ' ');
+        std::string out = indent + "switch (";
+        self().visit_expr(*x.m_test);
+        out += src + ") {\n";
+        indentation_level += 2;
+        for (size_t i=0; i<x.n_body; i++) {
+            ASR::stmt_t **m_body;
+            size_t n_body;
+            if (x.m_body[i]->type == ASR::case_stmtType::CaseStmt) {
+                ASR::CaseStmt_t *case_stmt = ASR::down_cast<ASR::CaseStmt_t>(x.m_body[i]);
+                for (size_t j=0; j<case_stmt->n_test; j++) {
+                    out += case_indent + "case " + std::to_string(
+                        get_case_value(case_stmt->m_test[j])) + ":\n";
+                }
+                m_body = case_stmt->m_body;
+                n_body = case_stmt->n_body;
+            } else {
+                ASR::CaseStmt_Range_t *case_range = ASR::down_cast<ASR::CaseStmt_Range_t>(x.m_body[i]);
+                if (case_range->m_start == nullptr || case_range->m_end == nullptr) {
+                    throw CodeGenError("Only closed ranges are supported in a select",
+                        x.base.base.loc);
+                }
+                int64_t end = get_case_value(case_range->m_end);
+                for (int64_t v=get_case_value(case_range->m_start); v<=end; v++) {
+                    out += case_indent + "case " + std::to_string(v) + ":\n";
+                }
+                m_body = case_range->m_body;
+                n_body = case_range->n_body;
+            }
+            current_body = "";
+            for (size_t j=0; j<n_body; j++) {
+                self().visit_stmt(*m_body[j]);
+                current_body += src;
+            }
+            out += case_indent + "{\n" + current_body;
+            out += case_indent + "    break;\n" + case_indent + "}\n";
+        }
+        if (x.n_default > 0) {
+            current_body = "";
+            for (size_t i=0; i<x.n_default; i++) {
+                self().visit_stmt(*x.m_default[i]);
+                current_body += src;
+            }
+            out += case_indent + "default: {\n" + current_body;
+            out += case_indent + "    break;\n" + case_indent + "}\n";
+        }
+        indentation_level -= 2;
+        out += indent + "}\n";
         src = out;
+        current_body = current_body_copy;
     }
 
     void visit_WhileLoop(const ASR::WhileLoop_t &x) {
@@ -21,7 +21,9 @@
 #include <llvm/IR/Intrinsics.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Module.h>
+#include <llvm/IR/Operator.h>
 #include <llvm/IR/Type.h>
 #include <llvm/Support/Casting.h>
 #include <llvm/Support/ManagedStatic.h>
@@ -38,16 +40,20 @@
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Path.h>
 #include <llvm/IR/DIBuilder.h>
+#include <llvm/ProfileData/InstrProfReader.h>
+#include <llvm/ProfileData/ProfileCommon.h>
 
 #include <libasr/asr.h>
 #include <libasr/containers.h>
 #include <libasr/codegen/asr_to_llvm.h>
 #include <libasr/pass/nested_vars.h>
+#include <libasr/pass/bounds_checks.h>
 #include <libasr/pass/pass_manager.h>
 #include <libasr/exception.h>
 #include <libasr/asr_utils.h>
 #include <libasr/codegen/llvm_utils.h>
 #include <libasr/codegen/llvm_array_utils.h>
+#include <libasr/codegen/evaluator.h>
 
 #if LLVM_VERSION_MAJOR >= 11
 #    define FIXED_VECTOR_TYPE llvm::FixedVectorType
@@ -130,6 +136,90 @@ void string_init(llvm::LLVMContext &context, llvm::Module &module,
     builder.CreateCall(fn, args);
 }
 
+// Collects the assignments `return_var = x` of a function, where `x` is a
+// local list, tuple or dict of the function and the assignment is directly
+// followed by a return. `x` is not used afterwards, so its value is moved to
+// the return variable instead of copied.
+class ReturnMoveCollector : public ASR::BaseWalkVisitor<ReturnMoveCollector>
+{
+private:
+    const ASR::Function_t &f;
+    std::set<const ASR::stmt_t*> &moves;
+
+    bool is_local_container(ASR::expr_t* x) {
+        if( !ASR::is_a<ASR::Var_t>(*x) ||
+            !ASR::is_a<ASR::Variable_t>(*ASR::down_cast<ASR::Var_t>(x)->m_v) ) {
+            return false;
+        }
+        ASR::Variable_t* v = ASRUtils::EXPR2VAR(x);
+        ASR::ttype_t* type = v->m_type;
+        return v->m_parent_symtab == f.m_symtab &&
+               v->m_intent == ASRUtils::intent_local &&
+               v->m_storage == ASR::storage_typeType::Default &&
+               (ASR::is_a<ASR::List_t>(*type) || ASR::is_a<ASR::Tuple_t>(*type) ||
+                ASR::is_a<ASR::Dict_t>(*type));
+    }
+
+    void check_body(ASR::stmt_t** body, size_t n_body, bool function_body) {
+        for( size_t i = 0; i < n_body; i++ ) {
+            if( !ASR::is_a<ASR::Assignment_t>(*body[i]) ) {
+                continue;
+            }
+            bool returns = (i + 1 < n_body && ASR::is_a<ASR::Return_t>(*body[i + 1])) ||
+                           (i + 1 == n_body && function_body);
+            ASR::Assignment_t* assignment = ASR::down_cast<ASR::Assignment_t>(body[i]);
+            if( returns && !assignment->m_overloaded &&
+                ASR::is_a<ASR::Var_t>(*assignment->m_target) &&
+                ASR::down_cast<ASR::Var_t>(assignment->m_target)->m_v ==
+                    ASR::down_cast<ASR::Var_t>(f.m_return_var)->m_v &&
+                is_local_container(assignment->m_value) ) {
+                moves.insert(body[i]);
+            }
+        }
+    }
+
+public:
+    ReturnMoveCollector(const ASR::Function_t &f_,
+        std::set<const ASR::stmt_t*> &moves_): f(f_), moves(moves_) {}
+
+    void collect() {
+        if( !f.m_return_var || !ASR::is_a<ASR::Var_t>(*f.m_return_var) ) {
+            return ;
+        }
+        check_body(f.m_body, f.n_body, true);
+        // Only the statements, the nested functions are collected separately
+        for( size_t i = 0; i < f.n_body; i++ ) {
+            visit_stmt(*f.m_body[i]);
+        }
+    }
+
+    void visit_If(const ASR::If_t &x) {
+        check_body(x.m_body, x.n_body, false);
+        check_body(x.m_orelse, x.n_orelse, false);
+        ASR::BaseWalkVisitor<ReturnMoveCollector>::visit_If(x);
+    }
+
+    void visit_WhileLoop(const ASR::WhileLoop_t &x) {
+        check_body(x.m_body, x.n_body, false);
+        ASR::BaseWalkVisitor<ReturnMoveCollector>::visit_WhileLoop(x);
+    }
+
+    void visit_DoLoop(const ASR::DoLoop_t &x) {
+        check_body(x.m_body, x.n_body, false);
+        ASR::BaseWalkVisitor<ReturnMoveCollector>::visit_DoLoop(x);
+    }
+
+    void visit_CaseStmt(const ASR::CaseStmt_t &x) {
+        check_body(x.m_body, x.n_body, false);
+        ASR::BaseWalkVisitor<ReturnMoveCollector>::visit_CaseStmt(x);
+    }
+
+    void visit_CaseStmt_Range(const ASR::CaseStmt_Range_t &x) {
+        check_body(x.m_body, x.n_body, false);
+        ASR::BaseWalkVisitor<ReturnMoveCollector>::visit_CaseStmt_Range(x);
+    }
+};
+
 class ASRToLLVMVisitor : public ASR::BaseVisitor<ASRToLLVMVisitor>
 {
 private:
@@ -167,6 +257,9 @@ public:
     llvm::BasicBlock *current_loophead, *current_loopend, *proc_return;
     std::string mangle_prefix;
     bool prototype_only;
+    // Definitions from modules compiled into several object files (with
+    // `separate_compilation`) are weak, so that they can be linked together
+    bool weak_definitions;
     llvm::StructType *complex_type_4, *complex_type_8;
     llvm::StructType *complex_type_4_ptr, *complex_type_8_ptr;
     llvm::PointerType *character_type;
@@ -187,6 +280,12 @@ public:
     std::map<uint64_t, llvm::Value*> llvm_symtab_fn_arg;
     std::map<uint64_t, llvm::BasicBlock*> llvm_goto_targets;
 
+    // The assignments of the function being generated that move their
+    // value instead of copying it (see `ReturnMoveCollector`)
+    std::set<const ASR::stmt_t*> move_assignments;
+    // The list items that need no bounds check (see `pass_eliminate_bounds_checks`)
+    std::set<const ASR::expr_t*> unchecked_list_items;
+
     // Data members for handling nested functions
     std::map<uint64_t, std::vector<uint64_t>> nesting_map; /* For saving the
         relationship between enclosing and nested functions */
@@ -232,6 +331,12 @@ public:
 
     CompilerOptions &compiler_options;
 
+    // For vectorizing the `DoConcurrentLoop`s: the width of the vector
+    // registers of the target (computed on first use) and the TBAA access
+    // tags of the array descriptors and of the array data
+    int vector_width;
+    llvm::MDNode *tbaa_descriptor, *tbaa_data;
+
     // For handling debug information
     std::unique_ptr<llvm::DIBuilder> DBuilder;
     llvm::DICompileUnit *debug_CU;
@@ -247,6 +352,7 @@ public:
     infile{infile},
     al{al},
     prototype_only(false),
+    weak_definitions(false),
     llvm_utils(std::make_unique<LLVMUtils>(context, builder.get())),
     list_api(std::make_unique<LLVMList>(context, llvm_utils.get(), builder.get())),
     tuple_api(std::make_unique<LLVMTuple>(context, llvm_utils.get(), builder.get())),
@@ -259,7 +365,10 @@ public:
     ptr_loads(2),
     lookup_enum_value_for_nonints(false),
     is_assignment_target(false),
-    compiler_options(compiler_options_)
+    compiler_options(compiler_options_),
+    vector_width(0),
+    tbaa_descriptor(nullptr),
+    tbaa_data(nullptr)
     {
         llvm_utils->tuple_api = tuple_api.get();
         llvm_utils->list_api = list_api.get();
@@ -1538,7 +1647,9 @@ public:
         ptr_loads = ptr_loads_copy;
         llvm::Value *pos = tmp;
 
-        tmp = list_api->read_item(plist, pos, compiler_options.enable_bounds_checking, *module,
+        bool check_bounds = compiler_options.enable_bounds_checking &&
+            unchecked_list_items.find(&x.base) == unchecked_list_items.end();
+        tmp = list_api->read_item(plist, pos, check_bounds, *module,
                 (LLVM::is_llvm_struct(el_type) || ptr_loads == 0));
     }
 
@@ -2280,7 +2391,19 @@ public:
     }
 
     void visit_Module(const ASR::Module_t &x) {
-        mangle_prefix = "__module_" + std::string(x.m_name) + "_";
+        std::string module_name = x.m_name;
+        if (compiler_options.separate_compilation) {
+            if (module_name == "__main__") {
+                // The module being compiled (`-c --disable-main`) is
+                // imported by its file name
+                module_name = llvm::sys::path::stem(infile).str();
+            } else {
+                // A dependency, its code is also present in the objects of
+                // the other modules that use it
+                weak_definitions = true;
+            }
+        }
+        mangle_prefix = "__module_" + module_name + "_";
 
         start_module_init_function_prototype(x);
 
@@ -2289,6 +2412,10 @@ public:
                 ASR::Variable_t *v = down_cast<ASR::Variable_t>(
                         item.second);
                 visit_Variable(*v);
+                llvm::GlobalVariable *g = module->getNamedGlobal(v->m_name);
+                if (weak_definitions && g && !g->isDeclaration()) {
+                    g->setLinkage(llvm::GlobalValue::WeakODRLinkage);
+                }
             }
             if (is_a<ASR::Function_t>(*item.second)) {
                 ASR::Function_t *v = down_cast<ASR::Function_t>(
@@ -2301,6 +2428,7 @@ public:
 
         visit_procedures(x);
         mangle_prefix = "";
+        weak_definitions = false;
     }
 
     void visit_Program(const ASR::Program_t &x) {
@@ -3602,6 +3730,9 @@ public:
         parent_function = &x;
         parent_function_hash = h;
         llvm::Function* F = llvm_symtab_fn[h];
+        if (weak_definitions) {
+            F->setLinkage(llvm::GlobalValue::WeakODRLinkage);
+        }
         if (compiler_options.emit_debug_info) debug_current_scope = llvm_symtab_fn_discope[h];
         proc_return = llvm::BasicBlock::Create(context, "return");
         llvm::BasicBlock *BB = llvm::BasicBlock::Create(context,
@@ -3683,9 +3814,13 @@ public:
             if (!prototype_only) {
                 define_function_entry(x);
 
+                std::set<const ASR::stmt_t*> move_assignments_copy;
+                std::swap(move_assignments, move_assignments_copy);
+                ReturnMoveCollector(x, move_assignments).collect();
                 for (size_t i=0; i<x.n_body; i++) {
                     this->visit_stmt(*x.m_body[i]);
                 }
+                std::swap(move_assignments, move_assignments_copy);
 
                 define_function_exit(x);
             }
@@ -3890,6 +4025,21 @@ public:
         }
     }
 
+    // Returns true if `x` evaluates to a new list, tuple or dict that
+    // nothing else refers to (the elements of constants and the results of
+    // functions are deep copies), so it can be moved instead of copied
+    bool is_temporary(ASR::expr_t* x) {
+        return ASR::is_a<ASR::ListConstant_t>(*x) ||
+               ASR::is_a<ASR::DictConstant_t>(*x) ||
+               ASR::is_a<ASR::FunctionCall_t>(*x);
+    }
+
+    // Moves the list, tuple or dict `value` to `target`: only the
+    // descriptor is copied, both share the data afterwards
+    void move_container(llvm::Value* value, llvm::Value* target) {
+        LLVM::CreateStore(*builder, LLVM::CreateLoad(*builder, value), target);
+    }
+
     void visit_Associate(const ASR::Associate_t& x) {
         ASR::Variable_t *asr_target = EXPR2VAR(x.m_target);
         ASR::Variable_t *asr_value = EXPR2VAR(x.m_value);
@@ -3915,6 +4065,8 @@ public:
         bool is_value_dict = ASR::is_a<ASR::Dict_t>(*asr_value_type);
         bool is_target_struct = ASR::is_a<ASR::Struct_t>(*asr_target_type);
         bool is_value_struct = ASR::is_a<ASR::Struct_t>(*asr_value_type);
+        bool is_move = is_temporary(x.m_value) ||
+            move_assignments.find(&x.base) != move_assignments.end();
         if( is_target_list && is_value_list ) {
             int64_t ptr_loads_copy = ptr_loads;
             ptr_loads = 0;
@@ -3925,10 +4077,13 @@ public:
             ptr_loads = ptr_loads_copy;
             ASR::List_t* value_asr_list = ASR::down_cast<ASR::List_t>(
                                             ASRUtils::expr_type(x.m_value));
-            std::string value_type_code = ASRUtils::get_type_code(value_asr_list->m_type);
-            list_api->list_deepcopy(value_list, target_list,
-                                    value_asr_list, module.get(),
-                                    name2memidx);
+            if( is_move ) {
+                move_container(value_list, target_list);
+            } else {
+                list_api->list_deepcopy(value_list, target_list,
+                                        value_asr_list, module.get(),
+                                        name2memidx);
+            }
             return ;
         } else if( is_target_tuple && is_value_tuple ) {
             int64_t ptr_loads_copy = ptr_loads;
@@ -3978,11 +4133,13 @@ public:
                 llvm::Value* target_tuple = tmp;
                 ptr_loads = ptr_loads_copy;
                 ASR::Tuple_t* value_tuple_type = ASR::down_cast<ASR::Tuple_t>(asr_value_type);
-                std::string type_code = ASRUtils::get_type_code(value_tuple_type->m_type,
-                                                                value_tuple_type->n_type);
-                tuple_api->tuple_deepcopy(value_tuple, target_tuple,
-                                          value_tuple_type, module.get(),
-                                          name2memidx);
+                if( is_move ) {
+                    move_container(value_tuple, target_tuple);
+                } else {
+                    tuple_api->tuple_deepcopy(value_tuple, target_tuple,
+                                              value_tuple_type, module.get(),
+                                              name2memidx);
+                }
             }
             return ;
         } else if( is_target_dict && is_value_dict ) {
@@ -3995,8 +4152,12 @@ public:
             ptr_loads = ptr_loads_copy;
             ASR::Dict_t* value_dict_type = ASR::down_cast<ASR::Dict_t>(asr_value_type);
             set_dict_api(value_dict_type);
-            llvm_utils->dict_api->dict_deepcopy(value_dict, target_dict,
-                                    value_dict_type, module.get(), name2memidx);
+            if( is_move ) {
+                move_container(value_dict, target_dict);
+            } else {
+                llvm_utils->dict_api->dict_deepcopy(value_dict, target_dict,
+                                        value_dict_type, module.get(), name2memidx);
+            }
             return ;
         } else if( is_target_struct && is_value_struct ) {
             int64_t ptr_loads_copy = ptr_loads;
@@ -4070,8 +4231,9 @@ public:
                 this->visit_expr_wrapper(asr_target0->m_pos, true);
                 llvm::Value* pos = tmp;
 
-                target = list_api->read_item(list, pos, compiler_options.enable_bounds_checking,
-                                             *module, true);
+                bool check_bounds = compiler_options.enable_bounds_checking &&
+                    unchecked_list_items.find(x.m_target) == unchecked_list_items.end();
+                target = list_api->read_item(list, pos, check_bounds, *module, true);
             }
         } else {
             ASR::Variable_t *asr_target = EXPR2VAR(x.m_target);
@@ -4452,20 +4614,95 @@ public:
         });
     }
 
+    // Adds the values of the case `x` to `switch_inst`, the values branch
+    // to `case_bb`
+    void add_switch_cases(llvm::SwitchInst *switch_inst, const ASR::case_stmt_t &x,
+                          llvm::BasicBlock *case_bb) {
+        llvm::IntegerType *type = llvm::cast<llvm::IntegerType>(
+            switch_inst->getCondition()->getType());
+        auto get_value = [&](ASR::expr_t *expr) -> int64_t {
+            ASR::expr_t *value = ASRUtils::expr_value(expr);
+            if (value == nullptr || !ASR::is_a<ASR::IntegerConstant_t>(*value)) {
+                throw CodeGenError("Only constant integer cases are supported in a select",
+                    x.base.loc);
+            }
+            return ASR::down_cast<ASR::IntegerConstant_t>(value)->m_n;
+        };
+        if (x.type == ASR::case_stmtType::CaseStmt) {
+            ASR::CaseStmt_t *case_stmt = ASR::down_cast<ASR::CaseStmt_t>(&x);
+            for (size_t i = 0; i < case_stmt->n_test; i++) {
+                switch_inst->addCase(llvm::ConstantInt::get(type,
+                    get_value(case_stmt->m_test[i]), true), case_bb);
+            }
+        } else {
+            ASR::CaseStmt_Range_t *case_range = ASR::down_cast<ASR::CaseStmt_Range_t>(&x);
+            if (case_range->m_start == nullptr || case_range->m_end == nullptr) {
+                throw CodeGenError("Only closed ranges are supported in a select",
+                    x.base.loc);
+            }
+            int64_t end = get_value(case_range->m_end);
+            for (int64_t v = get_value(case_range->m_start); v <= end; v++) {
+                switch_inst->addCase(llvm::ConstantInt::get(type, v, true), case_bb);
+            }
+        }
+    }
+
+    // The `select_case` pass keeps the selects with dense constant cases
+    // (`PassOptions::native_switch`), LLVM lowers their `switch` to a jump
+    // table
+    void visit_Select(const ASR::Select_t &x) {
+        this->visit_expr_wrapper(x.m_test, true);
+        llvm::Function *fn = builder->GetInsertBlock()->getParent();
+        llvm::BasicBlock *defaultBB = llvm::BasicBlock::Create(context, "select.default");
+        llvm::BasicBlock *endBB = llvm::BasicBlock::Create(context, "select.end");
+        llvm::SwitchInst *switch_inst = builder->CreateSwitch(tmp, defaultBB, x.n_body);
+        for (size_t i = 0; i < x.n_body; i++) {
+            llvm::BasicBlock *caseBB = llvm::BasicBlock::Create(context, "select.case", fn);
+            add_switch_cases(switch_inst, *x.m_body[i], caseBB);
+            builder->SetInsertPoint(caseBB);
+            if (x.m_body[i]->type == ASR::case_stmtType::CaseStmt) {
+                ASR::CaseStmt_t *case_stmt = ASR::down_cast<ASR::CaseStmt_t>(x.m_body[i]);
+                for (size_t j = 0; j < case_stmt->n_body; j++) {
+                    this->visit_stmt(*case_stmt->m_body[j]);
+                }
+            } else {
+                ASR::CaseStmt_Range_t *case_range = ASR::down_cast<ASR::CaseStmt_Range_t>(x.m_body[i]);
+                for (size_t j = 0; j < case_range->n_body; j++) {
+                    this->visit_stmt(*case_range->m_body[j]);
+                }
+            }
+            builder->CreateBr(endBB);
+        }
+        start_new_block(defaultBB); {
+            for (size_t i = 0; i < x.n_default; i++) {
+                this->visit_stmt(*x.m_default[i]);
+            }
+        }
+        start_new_block(endBB);
+    }
+
     void visit_IfExp(const ASR::IfExp_t &x) {
         // IfExp(expr test, expr body, expr orelse, ttype type, expr? value)
         this->visit_expr_wrapper(x.m_test, true);
         llvm::Value *cond = tmp;
         llvm::Value *then_val = nullptr;
         llvm::Value *else_val = nullptr;
-        create_if_else(cond, [=, &then_val]() {
+        llvm::BasicBlock *then_end = nullptr, *else_end = nullptr;
+        create_if_else(cond, [=, &then_val, &then_end]() {
             this->visit_expr_wrapper(x.m_body, true);
             then_val = tmp;
-        }, [=, &else_val]() {
+            then_end = builder->GetInsertBlock();
+        }, [=, &else_val, &else_end]() {
             this->visit_expr_wrapper(x.m_orelse, true);
             else_val = tmp;
+            else_end = builder->GetInsertBlock();
         });
-        tmp = builder->CreateSelect(cond, then_val, else_val);
+        // The branches can create new blocks, so the values are merged
+        // from the blocks in which they end
+        llvm::PHINode *phi = builder->CreatePHI(then_val->getType(), 2);
+        phi->addIncoming(then_val, then_end);
+        phi->addIncoming(else_val, else_end);
+        tmp = phi;
     }
 
     void visit_WhileLoop(const ASR::WhileLoop_t &x) {
@@ -4479,6 +4716,167 @@ public:
         });
     }
 
+    // Returns the TBAA access tag of the load or store through `ptr` in a
+    // `DoConcurrentLoop`: the fields of the array descriptors and the array
+    // elements (reached through the data pointer of a descriptor) never
+    // alias each other, everything else is left untagged.
+    llvm::MDNode* get_tbaa_access_tag(llvm::Value* ptr) {
+        llvm::GEPOperator* gep = llvm::dyn_cast<llvm::GEPOperator>(ptr);
+        if( gep == nullptr ) {
+            return nullptr;
+        }
+        if( tbaa_descriptor == nullptr ) {
+            llvm::MDBuilder md_builder(context);
+            llvm::MDNode* root = md_builder.createTBAARoot("LPython TBAA");
+            llvm::MDNode* descriptor = md_builder.createTBAAScalarTypeNode(
+                "array descriptor", root);
+            llvm::MDNode* data = md_builder.createTBAAScalarTypeNode(
+                "array data", root);
+            tbaa_descriptor = md_builder.createTBAAStructTagNode(descriptor, descriptor, 0);
+            tbaa_data = md_builder.createTBAAStructTagNode(data, data, 0);
+        }
+        if( arr_descr->is_descriptor_type(gep->getSourceElementType()) ) {
+            return tbaa_descriptor;
+        }
+        llvm::Type* el_type = gep->getSourceElementType();
+        if( !el_type->isIntegerTy() && !el_type->isFloatingPointTy() ) {
+            return nullptr;
+        }
+        llvm::LoadInst* data_ptr = llvm::dyn_cast<llvm::LoadInst>(gep->getPointerOperand());
+        if( data_ptr == nullptr ) {
+            return nullptr;
+        }
+        llvm::GEPOperator* data_gep = llvm::dyn_cast<llvm::GEPOperator>(
+            data_ptr->getPointerOperand());
+        if( data_gep && arr_descr->is_descriptor_type(data_gep->getSourceElementType()) ) {
+            return tbaa_data;
+        }
+        return nullptr;
+    }
+
+    // `DoConcurrentLoop`s are created by the `loop_vectorise` pass for the
+    // loops that can be vectorized. They are emitted as counted loops with
+    // bounds evaluated once and a private loop variable (its final value is
+    // stored after the loop), the memory accesses of the body get TBAA tags
+    // and the loop is marked for vectorization with the vector width of the
+    // target, so that LLVM's loop vectorizer (run with `--fast`) emits the
+    // vector instructions, the runtime alias checks and the remainder loop.
+    void visit_DoConcurrentLoop(const ASR::DoConcurrentLoop_t &x) {
+        int64_t increment = 1;
+        if( x.m_head.m_increment && (!ASRUtils::extract_value(
+                ASRUtils::expr_value(x.m_head.m_increment), increment) ||
+                increment == 0) ) {
+            throw CodeGenError("Only non-zero compile time constant increments "
+                "are supported in concurrent loops", x.base.base.loc);
+        }
+        ASR::Variable_t* v = ASRUtils::EXPR2VAR(x.m_head.m_v);
+        uint32_t h = get_hash((ASR::asr_t*)v);
+        LFORTRAN_ASSERT(llvm_symtab.find(h) != llvm_symtab.end());
+        llvm::Value* loop_var = llvm_symtab[h];
+        this->visit_expr_wrapper(x.m_head.m_start, true);
+        llvm::Value* start = tmp;
+        this->visit_expr_wrapper(x.m_head.m_end, true);
+        llvm::Value* end = tmp;
+        llvm::Value* step = llvm::ConstantInt::get(start->getType(), increment);
+
+        // Allocate the private loop variable at the beginning of the function
+        llvm::BasicBlock &entry_block = builder->GetInsertBlock()->getParent()->getEntryBlock();
+        llvm::IRBuilder<> builder0(context);
+        builder0.SetInsertPoint(&entry_block, entry_block.getFirstInsertionPt());
+        llvm::AllocaInst* index = builder0.CreateAlloca(start->getType(),
+            nullptr, "concurrent_index");
+        builder->CreateStore(start, index);
+
+        dict_api_lp->set_iterators();
+        dict_api_sc->set_iterators();
+        llvm::BasicBlock *loophead = llvm::BasicBlock::Create(context, "loop.head");
+        llvm::BasicBlock *loopbody = llvm::BasicBlock::Create(context, "loop.body");
+        llvm::BasicBlock *looplatch = llvm::BasicBlock::Create(context, "loop.latch");
+        llvm::BasicBlock *loopend = llvm::BasicBlock::Create(context, "loop.end");
+        llvm::BasicBlock *loophead_copy = current_loophead, *loopend_copy = current_loopend;
+        current_loophead = looplatch;
+        current_loopend = loopend;
+
+        start_new_block(loophead); {
+            llvm::Value* i = CreateLoad(index);
+            llvm::Value* cond = increment > 0 ? builder->CreateICmpSLE(i, end)
+                                              : builder->CreateICmpSGE(i, end);
+            builder->CreateCondBr(cond, loopbody, loopend);
+        }
+        start_new_block(loopbody); {
+            llvm_symtab[h] = index;
+            for (size_t i = 0; i < x.n_body; i++) {
+                this->visit_stmt(*x.m_body[i]);
+            }
+            llvm_symtab[h] = loop_var;
+        }
+        start_new_block(looplatch);
+
+        // Tag the memory accesses of the body, the blocks between
+        // `loopbody` and `looplatch`
+        int max_element_bits = 0;
+        for (auto bb = loopbody->getIterator(); &*bb != looplatch; bb++) {
+            for (llvm::Instruction &inst : *bb) {
+                llvm::Value* ptr = nullptr;
+                llvm::Type* access_type = nullptr;
+                if( llvm::LoadInst* load = llvm::dyn_cast<llvm::LoadInst>(&inst) ) {
+                    ptr = load->getPointerOperand();
+                    access_type = load->getType();
+                } else if( llvm::StoreInst* store = llvm::dyn_cast<llvm::StoreInst>(&inst) ) {
+                    ptr = store->getPointerOperand();
+                    access_type = store->getValueOperand()->getType();
+                } else {
+                    continue;
+                }
+                llvm::MDNode* tag = get_tbaa_access_tag(ptr);
+                if( tag == nullptr ) {
+                    continue;
+                }
+                inst.setMetadata(llvm::LLVMContext::MD_tbaa, tag);
+                if( tag == tbaa_data ) {
+                    max_element_bits = std::max(max_element_bits,
+                        (int) access_type->getPrimitiveSizeInBits());
+                }
+            }
+        }
+
+        {
+            llvm::Value* i = CreateLoad(index);
+            builder->CreateStore(builder->CreateAdd(i, step, "", false, true), index);
+            llvm::BranchInst* latch = builder->CreateBr(loophead);
+            if( vector_width == 0 ) {
+                vector_width = LLVMEvaluator::get_vector_width(
+                    compiler_options.target, compiler_options.target_cpu);
+            }
+            int vector_length = max_element_bits > 0 ? vector_width/max_element_bits : 0;
+            if( vector_length > 1 ) {
+                llvm::Type* i32 = llvm::Type::getInt32Ty(context);
+                llvm::Metadata* enable[] = {
+                    llvm::MDString::get(context, "llvm.loop.vectorize.enable"),
+                    llvm::ConstantAsMetadata::get(llvm::ConstantInt::getTrue(context))};
+                llvm::Metadata* width[] = {
+                    llvm::MDString::get(context, "llvm.loop.vectorize.width"),
+                    llvm::ConstantAsMetadata::get(llvm::ConstantInt::get(i32, vector_length))};
+                llvm::Metadata* loop_md[] = {nullptr,
+                    llvm::MDNode::get(context, enable),
+                    llvm::MDNode::get(context, width)};
+                llvm::MDNode* loop_id = llvm::MDNode::getDistinct(context, loop_md);
+                loop_id->replaceOperandWith(0, loop_id);
+                latch->setMetadata(llvm::LLVMContext::MD_loop, loop_id);
+            }
+        }
+
+        start_new_block(loopend);
+        // The value of the loop variable after the loop is the same as for
+        // the `DoLoop`: its last value, or `start - increment` if the body
+        // was never executed
+        builder->CreateStore(builder->CreateSub(CreateLoad(index), step), loop_var);
+        dict_api_lp->reset_iterators();
+        dict_api_sc->reset_iterators();
+        current_loophead = loophead_copy;
+        current_loopend = loopend_copy;
+    }
+
     void visit_Exit(const ASR::Exit_t & /* x */) {
         builder->CreateBr(current_loopend);
         llvm::BasicBlock *bb = llvm::BasicBlock::Create(context, "unreachable_after_exit");
@@ -6176,7 +6574,13 @@ public:
                                     ASR::is_a<ASR::StructInstanceMember_t>(*x.m_args[i].m_value) ) {
                                     value = CreateLoad(value);
                                 }
-                                if( !ASR::is_a<ASR::CPtr_t>(*arg_type) ) {
+                                if( (ASR::is_a<ASR::Tuple_t>(*arg_type) ||
+                                     ASR::is_a<ASR::List_t>(*arg_type)) &&
+                                    is_temporary(x.m_args[i].m_value) ) {
+                                    // Nothing else refers to the temporary,
+                                    // pass it without a copy
+                                    tmp = value;
+                                } else if( !ASR::is_a<ASR::CPtr_t>(*arg_type) ) {
                                     llvm::BasicBlock &entry_block = builder->GetInsertBlock()->getParent()->getEntryBlock();
                                     llvm::IRBuilder<> builder0(context);
                                     builder0.SetInsertPoint(&entry_block, entry_block.getFirstInsertionPt());
@@ -6604,6 +7008,42 @@ public:
 
 
 
+// Returns the functions that the profile `filename` (from `--profile-use`)
+// found cold: all their counts are below the cold threshold of its summary
+static std::set<std::string> get_cold_functions(const std::string &filename)
+{
+    std::set<std::string> cold, hot;
+    auto reader = llvm::IndexedInstrProfReader::create(filename);
+    if (!reader) {
+        // The LLVM pass reports the error when it reads the profile
+        llvm::consumeError(reader.takeError());
+        return cold;
+    }
+    uint64_t threshold = llvm::ProfileSummaryBuilder::getColdCountThreshold(
+        (*reader)->getSummary(false).getDetailedSummary());
+    for (const llvm::NamedInstrProfRecord &record: **reader) {
+        uint64_t max_count = 0;
+        for (uint64_t count: record.Counts) {
+            max_count = std::max(max_count, count);
+        }
+        // Internal functions are prefixed with the source file name
+        std::string name = record.Name.str();
+        name = name.substr(name.rfind(':') + 1);
+        if (max_count <= threshold) {
+            cold.insert(name);
+        } else {
+            hot.insert(name);
+        }
+    }
+    llvm::consumeError((*reader)->getError());
+    // A name can be in the profile more than once (functions from
+    // different modules), keep it if any of them is hot
+    for (auto &name: hot) {
+        cold.erase(name);
+    }
+    return cold;
+}
+
 Result<std::unique_ptr<LLVMModule>> asr_to_llvm(ASR::TranslationUnit_t &asr,
         diag::Diagnostics &diagnostics,
         llvm::LLVMContext &context, Allocator &al,
@@ -6615,12 +7055,32 @@ Result<std::unique_ptr<LLVMModule>> asr_to_llvm(ASR::TranslationUnit_t &asr,
     context.setOpaquePointers(false);
 #endif
     ASRToLLVMVisitor v(al, context, infile, co, diagnostics);
+    if (co.fast) {
+        // Allow the floating point operations to be contracted (`a*b + c`
+        // is emitted as a fused multiply-add on targets that have it)
+        llvm::FastMathFlags fmf;
+        fmf.setAllowContract();
+        v.builder->setFastMathFlags(fmf);
+    }
     LCompilers::PassOptions pass_options;
     pass_options.runtime_library_dir = co.runtime_library_dir;
     pass_options.mod_files_dir = co.mod_files_dir;
     pass_options.include_dirs = co.include_dirs;
     pass_options.run_fun = run_fn;
     pass_options.always_run = false;
+    pass_options.native_switch = true;
+    pass_options.inline_threshold = co.inline_threshold;
+    pass_options.inline_budget = co.inline_budget;
+    if (co.remarks) {
+        pass_options.remarks = &diagnostics;
+    }
+    if (!co.profile_use.empty()) {
+        pass_options.cold_functions = get_cold_functions(co.profile_use);
+    }
+    if (co.enable_bounds_checking) {
+        // Before the passes, the analysis needs the `DoLoop`s
+        pass_eliminate_bounds_checks(al, asr, v.unchecked_list_items);
+    }
     pass_manager.rtlib = co.rtlib;
     pass_manager.apply_passes(al, &asr, pass_options, diagnostics);
 
@@ -3,14 +3,17 @@
 #include <chrono>
 #include <iomanip>
 #include <fstream>
+#include <algorithm>
 
 #include <libasr/asr.h>
 #include <libasr/containers.h>
 #include <libasr/codegen/asr_to_wasm.h>
 #include <libasr/codegen/wasm_assembler.h>
 #include <libasr/pass/do_loops.h>
+#include <libasr/pass/loop_vectorise.h>
 #include <libasr/pass/unused_functions.h>
 #include <libasr/pass/pass_array_by_data.h>
+#include <libasr/pass/select_case.h>
 #include <libasr/exception.h>
 #include <libasr/asr_utils.h>
 
@@ -47,6 +50,33 @@ class CodeGenError {
 // Platform dependent fast unique hash:
 static uint64_t get_hash(ASR::asr_t *node) { return (uint64_t)node; }
 
+class SymbolUseVisitor : public ASR::BaseWalkVisitor<SymbolUseVisitor> {
+   public:
+    ASR::symbol_t *sym;
+    bool found;
+
+    SymbolUseVisitor(ASR::symbol_t *sym) : sym(sym), found(false) {}
+
+    void visit_Var(const ASR::Var_t &x) {
+        if (ASRUtils::symbol_get_past_external(x.m_v) == sym) {
+            found = true;
+        }
+    }
+};
+
+// The SIMD128 instructions are enabled by the `simd128` feature of the target,
+// as in `--target=wasm32+simd128`
+static bool target_has_simd128(const std::string &target) {
+    return target.find("+simd128") != std::string::npos;
+}
+
+// Returns true if the expression refers to the symbol `sym`
+static bool uses_symbol(ASR::expr_t *e, ASR::symbol_t *sym) {
+    SymbolUseVisitor v(sym);
+    v.visit_expr(*e);
+    return v.found;
+}
+
 struct ImportFunc {
     std::string name;
     std::vector<std::pair<ASR::ttypeType, uint32_t>> param_types, result_types;
@@ -61,6 +91,12 @@ struct SymbolFuncInfo {
     Vec<ASR::Variable_t *> referenced_vars;
 };
 
+struct SIMDLoopInfo {
+    uint32_t lane_size = 0;  // in bytes
+    // the reduction variables and the indices of their vector accumulators
+    std::vector<std::pair<ASR::Variable_t *, uint32_t>> reductions;
+};
+
 class ASRToWASMVisitor : public ASR::BaseVisitor<ASRToWASMVisitor> {
    public:
     Allocator &m_al;
@@ -73,6 +109,8 @@ class ASRToWASMVisitor : public ASR::BaseVisitor<ASRToWASMVisitor> {
     uint32_t nesting_level;
     uint32_t cur_loop_nesting_level;
     bool is_prototype_only;
+    bool simd;
+    bool fast;
 
     Vec<uint8_t> m_type_section;
     Vec<uint8_t> m_import_section;
@@ -86,6 +124,8 @@ class ASRToWASMVisitor : public ASR::BaseVisitor<ASRToWASMVisitor> {
     uint32_t no_of_imports;
     uint32_t no_of_data_segments;
     uint32_t avail_mem_loc;
+    // Memory used by `print_wasm_debug_statement`, set on its first use
+    uint32_t debug_mem_space = 0;
 
     uint32_t min_no_pages;
     uint32_t max_no_pages;
@@ -93,12 +133,21 @@ class ASRToWASMVisitor : public ASR::BaseVisitor<ASRToWASMVisitor> {
     std::map<uint64_t, uint32_t> m_var_name_idx_map;
     std::map<uint64_t, SymbolFuncInfo *> m_func_name_idx_map;
     std::map<std::string, ASR::asr_t *> m_import_func_asr_map;
+    std::map<uint64_t, SIMDLoopInfo> m_simd_loop_map;
+
+    // State of the concurrent loop being vectorised
+    ASR::symbol_t *simd_loop_var;
+    std::vector<ASR::symbol_t *> simd_reduction_vars;
 
    public:
-    ASRToWASMVisitor(Allocator &al, diag::Diagnostics &diagnostics)
+    ASRToWASMVisitor(Allocator &al, diag::Diagnostics &diagnostics,
+                     CompilerOptions &co)
         : m_al(al), diag(diagnostics) {
         intrinsic_module = false;
         is_prototype_only = false;
+        simd = target_has_simd128(co.target);
+        fast = co.fast;
+        simd_loop_var = nullptr;
         nesting_level = 0;
         cur_loop_nesting_level = 0;
         no_of_types = 0;
@@ -483,6 +532,9 @@ class ASRToWASMVisitor : public ASR::BaseVisitor<ASRToWASMVisitor> {
                 }
             }
         }
+        if (simd) {
+            declare_simd_loops(x.m_body, x.n_body, var_idx, local_vars_cnt);
+        }
         // fixup length of local vars list
         wasm::emit_u32_b32_idx(m_code_section, m_al,
                                len_idx_code_section_local_vars_list,
@@ -1323,6 +1375,18 @@ class ASRToWASMVisitor : public ASR::BaseVisitor<ASRToWASMVisitor> {
         }
     }
 
+    void visit_IfExp(const ASR::IfExp_t &x) {
+        if (x.m_value) {
+            this->visit_expr(*x.m_value);
+            return;
+        }
+        // Both values are computed, the expressions do not have side effects
+        this->visit_expr(*x.m_body);
+        this->visit_expr(*x.m_orelse);
+        this->visit_expr(*x.m_test);
+        wasm::emit_select(m_code_section, m_al);
+    }
+
     void visit_Var(const ASR::Var_t &x) {
         const ASR::symbol_t *s = ASRUtils::symbol_get_past_external(x.m_v);
         auto v = ASR::down_cast<ASR::Variable_t>(s);
@@ -1364,7 +1428,9 @@ class ASRToWASMVisitor : public ASR::BaseVisitor<ASRToWASMVisitor> {
     // following function is useful for printing debug statements from
     // webassembly
     void print_wasm_debug_statement(std::string message, bool endline = true) {
-        static int debug_mem_space = 10000 + avail_mem_loc;
+        if (debug_mem_space == 0) {
+            debug_mem_space = 10000 + avail_mem_loc;
+        }
         uint32_t avail_mem_loc_copy = avail_mem_loc;
         avail_mem_loc = debug_mem_space;
         emit_string(message);
@@ -2052,6 +2118,127 @@ class ASRToWASMVisitor : public ASR::BaseVisitor<ASRToWASMVisitor> {
         wasm::emit_expr_end(m_code_section, m_al);  // emit if end
     }
 
+    int64_t get_case_value(ASR::expr_t *x) {
+        ASR::expr_t *value = ASRUtils::expr_value(x);
+        if (value == nullptr || !ASR::is_a<ASR::IntegerConstant_t>(*value)) {
+            throw CodeGenError("Only constant integer cases are supported in a select",
+                x->base.loc);
+        }
+        return ASR::down_cast<ASR::IntegerConstant_t>(value)->m_n;
+    }
+
+    /*
+    The `select_case` pass keeps the selects with dense constant cases
+    (`PassOptions::native_switch`), they are dispatched by a `br_table` on
+    `test - min` (the smallest case value). A branch to a block continues
+    after its end, so the body of each case follows the end of its block:
+
+        block                   ;; end of the select
+          block                 ;; default
+            block               ;; case n - 1
+              ...
+                block           ;; case 0
+                  test - min
+                  br_table (the case of each value) (default)
+                end
+                case 0 body
+                br n            ;; to the end of the select
+              ...
+            end
+            case n - 1 body
+            br 1
+          end
+          default body
+        end
+    */
+    void visit_Select(const ASR::Select_t &x) {
+        size_t n = x.n_body;
+        std::vector<std::pair<int64_t, uint32_t>> values;
+        for (size_t i = 0; i < n; i++) {
+            if (x.m_body[i]->type == ASR::case_stmtType::CaseStmt) {
+                ASR::CaseStmt_t *case_stmt = ASR::down_cast<ASR::CaseStmt_t>(x.m_body[i]);
+                for (size_t j = 0; j < case_stmt->n_test; j++) {
+                    values.push_back({get_case_value(case_stmt->m_test[j]), i});
+                }
+            } else {
+                ASR::CaseStmt_Range_t *case_range = ASR::down_cast<ASR::CaseStmt_Range_t>(x.m_body[i]);
+                if (case_range->m_start == nullptr || case_range->m_end == nullptr) {
+                    throw CodeGenError("Only closed ranges are supported in a select",
+                        x.base.base.loc);
+                }
+                int64_t end = get_case_value(case_range->m_end);
+                for (int64_t v = get_case_value(case_range->m_start); v <= end; v++) {
+                    values.push_back({v, i});
+                }
+            }
+        }
+        if (values.empty()) {
+            for (size_t i = 0; i < x.n_default; i++) {
+                this->visit_stmt(*x.m_default[i]);
+            }
+            return;
+        }
+        int64_t min = values[0].first, max = values[0].first;
+        for (auto &v : values) {
+            min = std::min(min, v.first);
+            max = std::max(max, v.first);
+        }
+        std::vector<uint32_t> table(max - min + 1, n);
+        for (auto &v : values) {
+            table[v.first - min] = v.second;
+        }
+
+        for (size_t i = 0; i < n + 2; i++) {
+            wasm::emit_b8(m_code_section, m_al, 0x02);  // emit block start
+            wasm::emit_b8(m_code_section, m_al, 0x40);  // empty block type
+            nesting_level++;
+        }
+        int kind = ASRUtils::extract_kind_from_ttype_t(ASRUtils::expr_type(x.m_test));
+        if (kind == 8) {
+            // The table index is an i32, the values out of the range of the
+            // table go to the default first
+            this->visit_expr(*x.m_test);
+            wasm::emit_i64_const(m_code_section, m_al, min);
+            wasm::emit_i64_sub(m_code_section, m_al);
+            wasm::emit_i64_const(m_code_section, m_al, max - min);
+            wasm::emit_i64_gt_u(m_code_section, m_al);
+            wasm::emit_branch_if(m_code_section, m_al, n);
+            this->visit_expr(*x.m_test);
+            wasm::emit_i64_const(m_code_section, m_al, min);
+            wasm::emit_i64_sub(m_code_section, m_al);
+            wasm::emit_i32_wrap_i64(m_code_section, m_al);
+        } else {
+            this->visit_expr(*x.m_test);
+            wasm::emit_i32_const(m_code_section, m_al, min);
+            wasm::emit_i32_sub(m_code_section, m_al);
+        }
+        wasm::emit_branch_table(m_code_section, m_al, table, n);
+
+        for (size_t i = 0; i < n; i++) {
+            wasm::emit_expr_end(m_code_section, m_al);  // end of the case block
+            nesting_level--;
+            if (x.m_body[i]->type == ASR::case_stmtType::CaseStmt) {
+                ASR::CaseStmt_t *case_stmt = ASR::down_cast<ASR::CaseStmt_t>(x.m_body[i]);
+                for (size_t j = 0; j < case_stmt->n_body; j++) {
+                    this->visit_stmt(*case_stmt->m_body[j]);
+                }
+            } else {
+                ASR::CaseStmt_Range_t *case_range = ASR::down_cast<ASR::CaseStmt_Range_t>(x.m_body[i]);
+                for (size_t j = 0; j < case_range->n_body; j++) {
+                    this->visit_stmt(*case_range->m_body[j]);
+                }
+            }
+            wasm::emit_branch(m_code_section, m_al, n - i);  // to the end
+        }
+        wasm::emit_expr_end(m_code_section, m_al);  // end of the default block
+        nesting_level--;
+        for (size_t i = 0; i < x.n_default; i++) {
+            this->visit_stmt(*x.m_default[i]);
+        }
+        wasm::emit_expr_end(m_code_section, m_al);  // end of the select
+        nesting_level--;
+    }
+
     void visit_WhileLoop(const ASR::WhileLoop_t &x) {
         uint32_t prev_cur_loop_nesting_level = cur_loop_nesting_level;
         cur_loop_nesting_level = nesting_level;
@@ -2088,6 +2275,740 @@ class ASRToWASMVisitor : public ASR::BaseVisitor<ASRToWASMVisitor> {
         cur_loop_nesting_level = prev_cur_loop_nesting_level;
     }
 
+    /*
+    Loops are vectorised with the SIMD128 instructions if the target enables
+    them (`--target=wasm32+simd128`). The `loop_vectorise` pass turns the
+    vectorisable loops into concurrent loops, which are emitted as a vector
+    loop over 128 bit vectors followed by the scalar loop for the remaining
+    iterations. Reductions are accumulated lane-wise in a vector local and
+    combined into the scalar after the vector loop. Concurrent loops with a
+    body that cannot be expressed with vectors only get the scalar loop.
+    */
+
+    bool is_simd_lane_type(ASR::ttype_t *type, uint32_t &lane_size) {
+        if (ASRUtils::is_array(type) ||
+            !(ASRUtils::is_integer(*type) || ASRUtils::is_real(*type))) {
+            return false;
+        }
+        uint32_t kind = ASRUtils::extract_kind_from_ttype_t(type);
+        if (kind != 4 && kind != 8) {
+            return false;
+        }
+        if (lane_size == 0) {
+            lane_size = kind;
+        }
+        return lane_size == kind;
+    }
+
+    bool is_simd_reduction_var(ASR::symbol_t *s) {
+        return std::find(simd_reduction_vars.begin(), simd_reduction_vars.end(),
+                         s) != simd_reduction_vars.end();
+    }
+
+    bool uses_simd_reduction_var(ASR::expr_t *e) {
+        for (auto &s : simd_reduction_vars) {
+            if (uses_symbol(e, s)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Only the index of the contiguous dimension may depend on the loop
+    // variable, as `i` or `i +/- c`
+    bool is_simd_array_item(const ASR::ArrayItem_t &x, uint32_t &lane_size,
+                            bool is_target) {
+        if (!is_simd_lane_type(x.m_type, lane_size)) {
+            return false;
+        }
+        size_t contiguous_dim =
+            (x.m_storage_format == ASR::arraystorageType::ColMajor)
+                ? 0
+                : x.n_args - 1;
+        bool uses_loop_var = false;
+        for (size_t i = 0; i < x.n_args; i++) {
+            ASR::expr_t *idx = x.m_args[i].m_right;
+            if (!idx || x.m_args[i].m_left || x.m_args[i].m_step ||
+                uses_simd_reduction_var(idx)) {
+                return false;
+            }
+            if (!uses_symbol(idx, simd_loop_var)) {
+                continue;
+            }
+            if (i != contiguous_dim) {
+                return false;
+            }
+            if (ASR::is_a<ASR::IntegerBinOp_t>(*idx)) {
+                ASR::IntegerBinOp_t *b =
+                    ASR::down_cast<ASR::IntegerBinOp_t>(idx);
+                if ((b->m_op != ASR::binopType::Add &&
+                     b->m_op != ASR::binopType::Sub) ||
+                    uses_symbol(b->m_right, simd_loop_var)) {
+                    return false;
+                }
+                idx = b->m_left;
+            }
+            if (!ASR::is_a<ASR::Var_t>(*idx)) {
+                return false;
+            }
+            uses_loop_var = true;
+        }
+        // Every lane would store to the same element
+        return uses_loop_var || !is_target;
+    }
+
+    bool is_simd_expr(ASR::expr_t *e, uint32_t &lane_size) {
+        ASR::expr_t *value = ASRUtils::expr_value(e);
+        if (value && (ASR::is_a<ASR::IntegerConstant_t>(*value) ||
+                      ASR::is_a<ASR::RealConstant_t>(*value))) {
+            return is_simd_lane_type(ASRUtils::expr_type(e), lane_size);
+        }
+        switch (e->type) {
+            case ASR::exprType::Var: {
+                ASR::symbol_t *s = ASRUtils::symbol_get_past_external(
+                    ASR::down_cast<ASR::Var_t>(e)->m_v);
+                return !is_simd_reduction_var(s) &&
+                       is_simd_lane_type(ASRUtils::expr_type(e), lane_size);
+            }
+            case ASR::exprType::ArrayItem: {
+                return is_simd_array_item(*ASR::down_cast<ASR::ArrayItem_t>(e),
+                                          lane_size, false);
+            }
+            case ASR::exprType::IntegerBinOp: {
+                ASR::IntegerBinOp_t *b = ASR::down_cast<ASR::IntegerBinOp_t>(e);
+                return (b->m_op == ASR::binopType::Add ||
+                        b->m_op == ASR::binopType::Sub ||
+                        b->m_op == ASR::binopType::Mul) &&
+                       is_simd_lane_type(b->m_type, lane_size) &&
+                       is_simd_expr(b->m_left, lane_size) &&
+                       is_simd_expr(b->m_right, lane_size);
+            }
+            case ASR::exprType::RealBinOp: {
+                ASR::RealBinOp_t *b = ASR::down_cast<ASR::RealBinOp_t>(e);
+                return b->m_op != ASR::binopType::Pow &&
+                       is_simd_lane_type(b->m_type, lane_size) &&
+                       is_simd_expr(b->m_left, lane_size) &&
+                       is_simd_expr(b->m_right, lane_size);
+            }
+            case ASR::exprType::IntegerUnaryMinus: {
+                ASR::IntegerUnaryMinus_t *u =
+                    ASR::down_cast<ASR::IntegerUnaryMinus_t>(e);
+                return is_simd_expr(u->m_arg, lane_size);
+            }
+            case ASR::exprType::RealUnaryMinus: {
+                ASR::RealUnaryMinus_t *u =
+                    ASR::down_cast<ASR::RealUnaryMinus_t>(e);
+                return is_simd_expr(u->m_arg, lane_size);
+            }
+            case ASR::exprType::Cast: {
+                // The lanes keep their size, so that only the conversions
+                // between 32 bit integers and reals are available
+                ASR::Cast_t *c = ASR::down_cast<ASR::Cast_t>(e);
+                int arg_kind = -1, dest_kind = -1;
+                extract_kinds(*c, arg_kind, dest_kind);
+                if (arg_kind != dest_kind) {
+                    return false;
+                }
+                if (c->m_kind == ASR::cast_kindType::IntegerToReal ||
+                    c->m_kind == ASR::cast_kindType::RealToInteger) {
+                    if (arg_kind != 4) {
+                        return false;
+                    }
+                } else if (c->m_kind != ASR::cast_kindType::IntegerToInteger &&
+                           c->m_kind != ASR::cast_kindType::RealToReal) {
+                    return false;
+                }
+                return is_simd_lane_type(c->m_type, lane_size) &&
+                       is_simd_expr(c->m_arg, lane_size);
+            }
+            case ASR::exprType::IfExp: {
+                ASR::IfExp_t *i = ASR::down_cast<ASR::IfExp_t>(e);
+                return is_simd_lane_type(i->m_type, lane_size) &&
+                       is_simd_mask(i->m_test, lane_size) &&
+                       is_simd_expr(i->m_body, lane_size) &&
+                       is_simd_expr(i->m_orelse, lane_size);
+            }
+            default:
+                return false;
+        }
+    }
+
+    // Logical expressions are vectors of lanes with all bits set (true) or
+    // cleared (false), of the size of the compared values
+    bool is_simd_mask(ASR::expr_t *e, uint32_t &lane_size) {
+        switch (e->type) {
+            case ASR::exprType::IntegerCompare: {
+                ASR::IntegerCompare_t *c =
+                    ASR::down_cast<ASR::IntegerCompare_t>(e);
+                return is_simd_expr(c->m_left, lane_size) &&
+                       is_simd_expr(c->m_right, lane_size);
+            }
+            case ASR::exprType::RealCompare: {
+                ASR::RealCompare_t *c = ASR::down_cast<ASR::RealCompare_t>(e);
+                return is_simd_expr(c->m_left, lane_size) &&
+                       is_simd_expr(c->m_right, lane_size);
+            }
+            case ASR::exprType::LogicalBinOp: {
+                ASR::LogicalBinOp_t *b = ASR::down_cast<ASR::LogicalBinOp_t>(e);
+                return (b->m_op == ASR::logicalbinopType::And ||
+                        b->m_op == ASR::logicalbinopType::Or) &&
+                       is_simd_mask(b->m_left, lane_size) &&
+                       is_simd_mask(b->m_right, lane_size);
+            }
+            case ASR::exprType::LogicalNot: {
+                return is_simd_mask(ASR::down_cast<ASR::LogicalNot_t>(e)->m_arg,
+                                    lane_size);
+            }
+            default:
+                return false;
+        }
+    }
+
+    // Returns the operand of a reduction `s = s op e` (or `s = e op s`), op
+    // being an addition or a multiplication
+    ASR::expr_t *get_simd_reduction_operand(ASR::symbol_t *s,
+                                            ASR::expr_t *value,
+                                            ASR::binopType &op) {
+        ASR::expr_t *left, *right;
+        if (ASR::is_a<ASR::IntegerBinOp_t>(*value)) {
+            ASR::IntegerBinOp_t *b = ASR::down_cast<ASR::IntegerBinOp_t>(value);
+            op = b->m_op;
+            left = b->m_left;
+            right = b->m_right;
+        } else if (ASR::is_a<ASR::RealBinOp_t>(*value) && fast) {
+            // Reordering the additions of reals changes the rounding
+            ASR::RealBinOp_t *b = ASR::down_cast<ASR::RealBinOp_t>(value);
+            op = b->m_op;
+            left = b->m_left;
+            right = b->m_right;
+        } else {
+            return nullptr;
+        }
+        if (op != ASR::binopType::Add && op != ASR::binopType::Mul) {
+            return nullptr;
+        }
+        if (ASR::is_a<ASR::Var_t>(*left) &&
+            ASRUtils::symbol_get_past_external(
+                ASR::down_cast<ASR::Var_t>(left)->m_v) == s) {
+            return right;
+        }
+        if (ASR::is_a<ASR::Var_t>(*right) &&
+            ASRUtils::symbol_get_past_external(
+                ASR::down_cast<ASR::Var_t>(right)->m_v) == s) {
+            return left;
+        }
+        return nullptr;
+    }
+
+    bool is_simd_loop(const ASR::DoConcurrentLoop_t &x, SIMDLoopInfo &info) {
+        if (x.m_head.m_increment) {
+            ASR::expr_t *inc = ASRUtils::expr_value(x.m_head.m_increment);
+            int64_t inc_value = 0;
+            if (!inc || !ASRUtils::extract_value(inc, inc_value) ||
+                inc_value != 1) {
+                return false;
+            }
+        }
+        simd_loop_var = ASRUtils::symbol_get_past_external(
+            ASR::down_cast<ASR::Var_t>(x.m_head.m_v)->m_v);
+        simd_reduction_vars.clear();
+        for (size_t i = 0; i < x.n_body; i++) {
+            if (!ASR::is_a<ASR::Assignment_t>(*x.m_body[i])) {
+                return false;
+            }
+            ASR::expr_t *target =
+                ASR::down_cast<ASR::Assignment_t>(x.m_body[i])->m_target;
+            if (ASR::is_a<ASR::Var_t>(*target)) {
+                ASR::symbol_t *s = ASRUtils::symbol_get_past_external(
+                    ASR::down_cast<ASR::Var_t>(target)->m_v);
+                if (s == simd_loop_var || is_simd_reduction_var(s)) {
+                    return false;
+                }
+                simd_reduction_vars.push_back(s);
+            }
+        }
+        uint32_t lane_size = 0;
+        for (size_t i = 0; i < x.n_body; i++) {
+            ASR::Assignment_t *a =
+                ASR::down_cast<ASR::Assignment_t>(x.m_body[i]);
+            if (ASR::is_a<ASR::ArrayItem_t>(*a->m_target)) {
+                if (!is_simd_array_item(
+                        *ASR::down_cast<ASR::ArrayItem_t>(a->m_target),
+                        lane_size, true) ||
+                    !is_simd_expr(a->m_value, lane_size)) {
+                    return false;
+                }
+            } else if (ASR::is_a<ASR::Var_t>(*a->m_target)) {
+                ASR::symbol_t *s = ASRUtils::symbol_get_past_external(
+                    ASR::down_cast<ASR::Var_t>(a->m_target)->m_v);
+                ASR::binopType op;
+                ASR::expr_t *operand =
+                    get_simd_reduction_operand(s, a->m_value, op);
+                if (!operand ||
+                    !is_simd_lane_type(ASRUtils::expr_type(a->m_target),
+                                       lane_size) ||
+                    !is_simd_expr(operand, lane_size)) {
+                    return false;
+                }
+                info.reductions.push_back(
+                    {ASR::down_cast<ASR::Variable_t>(s), 0U});
+            } else {
+                return false;
+            }
+        }
+        if (lane_size == 0) {
+            return false;
+        }
+        info.lane_size = lane_size;
+        return true;
+    }
+
+    // Finds the concurrent loops of the body which are vectorised and
+    // declares the vector locals of their reductions
+    void declare_simd_loops(ASR::stmt_t **body, size_t n_body, int &var_idx,
+                            int &local_vars_cnt) {
+        for (size_t i = 0; i < n_body; i++) {
+            ASR::stmt_t *s = body[i];
+            if (ASR::is_a<ASR::If_t>(*s)) {
+                ASR::If_t *x = ASR::down_cast<ASR::If_t>(s);
+                declare_simd_loops(x->m_body, x->n_body, var_idx,
+                                   local_vars_cnt);
+                declare_simd_loops(x->m_orelse, x->n_orelse, var_idx,
+                                   local_vars_cnt);
+            } else if (ASR::is_a<ASR::WhileLoop_t>(*s)) {
+                ASR::WhileLoop_t *x = ASR::down_cast<ASR::WhileLoop_t>(s);
+                declare_simd_loops(x->m_body, x->n_body, var_idx,
+                                   local_vars_cnt);
+            } else if (ASR::is_a<ASR::DoConcurrentLoop_t>(*s)) {
+                SIMDLoopInfo info;
+                if (!is_simd_loop(*ASR::down_cast<ASR::DoConcurrentLoop_t>(s),
+                                  info)) {
+                    continue;
+                }
+                for (auto &reduction : info.reductions) {
+                    wasm::emit_u32(m_code_section, m_al, 1U);
+                    wasm::emit_b8(m_code_section, m_al, wasm::type::v128);
+                    reduction.second = var_idx++;
+                    local_vars_cnt++;
+                }
+                m_simd_loop_map[get_hash((ASR::asr_t *)s)] = info;
+            }
+        }
+    }
+
+    // Emits the instruction for the type of the lanes (or the scalar type)
+    void emit_typed_inst(ASR::ttype_t *type,
+                         void (*i32_inst)(Vec<uint8_t> &, Allocator &),
+                         void (*i64_inst)(Vec<uint8_t> &, Allocator &),
+                         void (*f32_inst)(Vec<uint8_t> &, Allocator &),
+                         void (*f64_inst)(Vec<uint8_t> &, Allocator &)) {
+        bool is_32_bit = (ASRUtils::extract_kind_from_ttype_t(type) == 4);
+        if (ASRUtils::is_integer(*type)) {
+            (is_32_bit ? i32_inst : i64_inst)(m_code_section, m_al);
+        } else {
+            (is_32_bit ? f32_inst : f64_inst)(m_code_section, m_al);
+        }
+    }
+
+    void emit_simd_splat(ASR::ttype_t *type) {
+        emit_typed_inst(type, wasm::emit_i32x4_splat, wasm::emit_i64x2_splat,
+                        wasm::emit_f32x4_splat, wasm::emit_f64x2_splat);
+    }
+
+    void emit_simd_binop(ASR::ttype_t *type, ASR::binopType op) {
+        switch (op) {
+            case ASR::binopType::Add: {
+                emit_typed_inst(type, wasm::emit_i32x4_add,
+                                wasm::emit_i64x2_add, wasm::emit_f32x4_add,
+                                wasm::emit_f64x2_add);
+                break;
+            }
+            case ASR::binopType::Sub: {
+                emit_typed_inst(type, wasm::emit_i32x4_sub,
+                                wasm::emit_i64x2_sub, wasm::emit_f32x4_sub,
+                                wasm::emit_f64x2_sub);
+                break;
+            }
+            case ASR::binopType::Mul: {
+                emit_typed_inst(type, wasm::emit_i32x4_mul,
+                                wasm::emit_i64x2_mul, wasm::emit_f32x4_mul,
+                                wasm::emit_f64x2_mul);
+                break;
+            }
+            case ASR::binopType::Div: {
+                LFORTRAN_ASSERT(ASRUtils::is_real(*type));
+                emit_typed_inst(type, nullptr, nullptr, wasm::emit_f32x4_div,
+                                wasm::emit_f64x2_div);
+                break;
+            }
+            default:
+                throw CodeGenError("SIMD: Unsupported binary operation");
+        }
+    }
+
+    void emit_simd_compare(ASR::ttype_t *type, ASR::cmpopType op) {
+        switch (op) {
+            case ASR::cmpopType::Eq: {
+                emit_typed_inst(type, wasm::emit_i32x4_eq, wasm::emit_i64x2_eq,
+                                wasm::emit_f32x4_eq, wasm::emit_f64x2_eq);
+                break;
+            }
+            case ASR::cmpopType::NotEq: {
+                emit_typed_inst(type, wasm::emit_i32x4_ne, wasm::emit_i64x2_ne,
+                                wasm::emit_f32x4_ne, wasm::emit_f64x2_ne);
+                break;
+            }
+            case ASR::cmpopType::Lt: {
+                emit_typed_inst(type, wasm::emit_i32x4_lt_s,
+                                wasm::emit_i64x2_lt_s, wasm::emit_f32x4_lt,
+                                wasm::emit_f64x2_lt);
+                break;
+            }
+            case ASR::cmpopType::LtE: {
+                emit_typed_inst(type, wasm::emit_i32x4_le_s,
+                                wasm::emit_i64x2_le_s, wasm::emit_f32x4_le,
+                                wasm::emit_f64x2_le);
+                break;
+            }
+            case ASR::cmpopType::Gt: {
+                emit_typed_inst(type, wasm::emit_i32x4_gt_s,
+                                wasm::emit_i64x2_gt_s, wasm::emit_f32x4_gt,
+                                wasm::emit_f64x2_gt);
+                break;
+            }
+            case ASR::cmpopType::GtE: {
+                emit_typed_inst(type, wasm::emit_i32x4_ge_s,
+                                wasm::emit_i64x2_ge_s, wasm::emit_f32x4_ge,
+                                wasm::emit_f64x2_ge);
+                break;
+            }
+            default:
+                throw CodeGenError("SIMD: Unsupported comparison");
+        }
+    }
+
+    // Emits the vector of the values of `e` for the lanes starting at the
+    // current value of the loop variable
+    void emit_simd_expr(ASR::expr_t *e) {
+        ASR::ttype_t *type = ASRUtils::expr_type(e);
+        ASR::expr_t *value = ASRUtils::expr_value(e);
+        if (value && (ASR::is_a<ASR::IntegerConstant_t>(*value) ||
+                      ASR::is_a<ASR::RealConstant_t>(*value))) {
+            this->visit_expr(*value);
+            emit_simd_splat(type);
+            return;
+        }
+        switch (e->type) {
+            case ASR::exprType::Var: {
+                this->visit_expr(*e);
+                emit_simd_splat(type);
+                if (ASRUtils::symbol_get_past_external(
+                        ASR::down_cast<ASR::Var_t>(e)->m_v) == simd_loop_var) {
+                    // (i, i + 1, ...)
+                    uint32_t kind = ASRUtils::extract_kind_from_ttype_t(type);
+                    for (uint8_t lane = 1; lane < 16 / kind; lane++) {
+                        this->visit_expr(*e);
+                        if (kind == 4) {
+                            wasm::emit_i32_const(m_code_section, m_al, lane);
+                            wasm::emit_i32_add(m_code_section, m_al);
+                            wasm::emit_i32x4_replace_lane(m_code_section, m_al,
+                                                          lane);
+                        } else {
+                            wasm::emit_i64_const(m_code_section, m_al, lane);
+                            wasm::emit_i64_add(m_code_section, m_al);
+                            wasm::emit_i64x2_replace_lane(m_code_section, m_al,
+                                                          lane);
+                        }
+                    }
+                }
+                break;
+            }
+            case ASR::exprType::ArrayItem: {
+                ASR::ArrayItem_t *x = ASR::down_cast<ASR::ArrayItem_t>(e);
+                bool uses_loop_var = false;
+                for (size_t i = 0; i < x->n_args; i++) {
+                    uses_loop_var = uses_loop_var ||
+                        uses_symbol(x->m_args[i].m_right, simd_loop_var);
+                }
+                if (uses_loop_var) {
+                    emit_array_item_address_onto_stack(*x);
+                    wasm::emit_v128_load(m_code_section, m_al,
+                                         wasm::mem_align::b8, 0);
+                } else {
+                    this->visit_expr(*e);
+                    emit_simd_splat(type);
+                }
+                break;
+            }
+            case ASR::exprType::IntegerBinOp: {
+                ASR::IntegerBinOp_t *b = ASR::down_cast<ASR::IntegerBinOp_t>(e);
+                emit_simd_expr(b->m_left);
+                emit_simd_expr(b->m_right);
+                emit_simd_binop(type, b->m_op);
+                break;
+            }
+            case ASR::exprType::RealBinOp: {
+                ASR::RealBinOp_t *b = ASR::down_cast<ASR::RealBinOp_t>(e);
+                emit_simd_expr(b->m_left);
+                emit_simd_expr(b->m_right);
+                emit_simd_binop(type, b->m_op);
+                break;
+            }
+            case ASR::exprType::IntegerUnaryMinus: {
+                emit_simd_expr(
+                    ASR::down_cast<ASR::IntegerUnaryMinus_t>(e)->m_arg);
+                emit_typed_inst(type, wasm::emit_i32x4_neg,
+                                wasm::emit_i64x2_neg, nullptr, nullptr);
+                break;
+            }
+            case ASR::exprType::RealUnaryMinus: {
+                emit_simd_expr(ASR::down_cast<ASR::RealUnaryMinus_t>(e)->m_arg);
+                emit_typed_inst(type, nullptr, nullptr, wasm::emit_f32x4_neg,
+                                wasm::emit_f64x2_neg);
+                break;
+            }
+            case ASR::exprType::Cast: {
+                ASR::Cast_t *c = ASR::down_cast<ASR::Cast_t>(e);
+                emit_simd_expr(c->m_arg);
+                if (c->m_kind == ASR::cast_kindType::IntegerToReal) {
+                    wasm::emit_f32x4_convert_i32x4_s(m_code_section, m_al);
+                } else if (c->m_kind == ASR::cast_kindType::RealToInteger) {
+                    wasm::emit_i32x4_trunc_sat_f32x4_s(m_code_section, m_al);
+                }
+                break;
+            }
+            case ASR::exprType::IfExp: {
+                ASR::IfExp_t *i = ASR::down_cast<ASR::IfExp_t>(e);
+                emit_simd_expr(i->m_body);
+                emit_simd_expr(i->m_orelse);
+                emit_simd_mask(i->m_test);
+                wasm::emit_v128_bitselect(m_code_section, m_al);
+                break;
+            }
+            default:
+                throw CodeGenError("SIMD: Unsupported expression");
+        }
+    }
+
+    void emit_simd_mask(ASR::expr_t *e) {
+        switch (e->type) {
+            case ASR::exprType::IntegerCompare: {
+                ASR::IntegerCompare_t *c =
+                    ASR::down_cast<ASR::IntegerCompare_t>(e);
+                emit_simd_expr(c->m_left);
+                emit_simd_expr(c->m_right);
+                emit_simd_compare(ASRUtils::expr_type(c->m_left), c->m_op);
+                break;
+            }
+            case ASR::exprType::RealCompare: {
+                ASR::RealCompare_t *c = ASR::down_cast<ASR::RealCompare_t>(e);
+                emit_simd_expr(c->m_left);
+                emit_simd_expr(c->m_right);
+                emit_simd_compare(ASRUtils::expr_type(c->m_left), c->m_op);
+                break;
+            }
+            case ASR::exprType::LogicalBinOp: {
+                ASR::LogicalBinOp_t *b = ASR::down_cast<ASR::LogicalBinOp_t>(e);
+                emit_simd_mask(b->m_left);
+                emit_simd_mask(b->m_right);
+                if (b->m_op == ASR::logicalbinopType::And) {
+                    wasm::emit_v128_and(m_code_section, m_al);
+                } else {
+                    wasm::emit_v128_or(m_code_section, m_al);
+                }
+                break;
+            }
+            case ASR::exprType::LogicalNot: {
+                emit_simd_mask(ASR::down_cast<ASR::LogicalNot_t>(e)->m_arg);
+                wasm::emit_v128_not(m_code_section, m_al);
+                break;
+            }
+            default:
+                throw CodeGenError("SIMD: Unsupported logical expression");
+        }
+    }
+
+    void emit_simd_stmt(const ASR::Assignment_t &x, const SIMDLoopInfo &info) {
+        if (ASR::is_a<ASR::ArrayItem_t>(*x.m_target)) {
+            emit_array_item_address_onto_stack(
+                *ASR::down_cast<ASR::ArrayItem_t>(x.m_target));
+            emit_simd_expr(x.m_value);
+            wasm::emit_v128_store(m_code_section, m_al, wasm::mem_align::b8,
+                                  0);
+            return;
+        }
+        ASR::symbol_t *s = ASRUtils::symbol_get_past_external(
+            ASR::down_cast<ASR::Var_t>(x.m_target)->m_v);
+        for (auto &reduction : info.reductions) {
+            if ((ASR::symbol_t *)reduction.first == s) {
+                ASR::binopType op;
+                ASR::expr_t *operand =
+                    get_simd_reduction_operand(s, x.m_value, op);
+                wasm::emit_get_local(m_code_section, m_al, reduction.second);
+                emit_simd_expr(operand);
+                emit_simd_binop(reduction.first->m_type, op);
+                wasm::emit_set_local(m_code_section, m_al, reduction.second);
+            }
+        }
+    }
+
+    // Initializes the vector accumulator of a reduction with the identity of
+    // the operation (if `init`), or combines its lanes into the scalar
+    void emit_simd_reduction(const ASR::DoConcurrentLoop_t &x,
+                             const std::pair<ASR::Variable_t *, uint32_t> &r,
+                             bool init) {
+        ASR::binopType op = ASR::binopType::Add;
+        for (size_t i = 0; i < x.n_body; i++) {
+            ASR::Assignment_t *a =
+                ASR::down_cast<ASR::Assignment_t>(x.m_body[i]);
+            if (ASR::is_a<ASR::Var_t>(*a->m_target) &&
+                ASRUtils::symbol_get_past_external(
+                    ASR::down_cast<ASR::Var_t>(a->m_target)->m_v) ==
+                    (ASR::symbol_t *)r.first) {
+                get_simd_reduction_operand((ASR::symbol_t *)r.first,
+                                           a->m_value, op);
+            }
+        }
+        ASR::ttype_t *type = r.first->m_type;
+        uint32_t kind = ASRUtils::extract_kind_from_ttype_t(type);
+        bool is_int = ASRUtils::is_integer(*type);
+        int identity = (op == ASR::binopType::Add) ? 0 : 1;
+        if (init) {
+            if (is_int && kind == 4) {
+                wasm::emit_i32_const(m_code_section, m_al, identity);
+            } else if (is_int) {
+                wasm::emit_i64_const(m_code_section, m_al, identity);
+            } else if (kind == 4) {
+                wasm::emit_f32_const(m_code_section, m_al, identity);
+            } else {
+                wasm::emit_f64_const(m_code_section, m_al, identity);
+            }
+            emit_simd_splat(type);
+            wasm::emit_set_local(m_code_section, m_al, r.second);
+            return;
+        }
+        uint32_t s_idx = m_var_name_idx_map[get_hash((ASR::asr_t *)r.first)];
+        wasm::emit_get_local(m_code_section, m_al, s_idx);
+        for (uint8_t lane = 0; lane < 16 / kind; lane++) {
+            wasm::emit_get_local(m_code_section, m_al, r.second);
+            if (is_int && kind == 4) {
+                wasm::emit_i32x4_extract_lane(m_code_section, m_al, lane);
+            } else if (is_int) {
+                wasm::emit_i64x2_extract_lane(m_code_section, m_al, lane);
+            } else if (kind == 4) {
+                wasm::emit_f32x4_extract_lane(m_code_section, m_al, lane);
+            } else {
+                wasm::emit_f64x2_extract_lane(m_code_section, m_al, lane);
+            }
+            if (op == ASR::binopType::Add) {
+                emit_typed_inst(type, wasm::emit_i32_add, wasm::emit_i64_add,
+                                wasm::emit_f32_add, wasm::emit_f64_add);
+            } else {
+                emit_typed_inst(type, wasm::emit_i32_mul, wasm::emit_i64_mul,
+                                wasm::emit_f32_mul, wasm::emit_f64_mul);
+            }
+        }
+        wasm::emit_set_local(m_code_section, m_al, s_idx);
+    }
+
+    // Emits the loop over the iterations `i, i + 1, ..., i + lanes - 1` while
+    // they are all in the range of the concurrent loop
+    void emit_concurrent_loop(const ASR::DoConcurrentLoop_t &x,
+                              const SIMDLoopInfo *info) {
+        ASR::Variable_t *v = ASRUtils::EXPR2VAR(x.m_head.m_v);
+        uint32_t idx = m_var_name_idx_map[get_hash((ASR::asr_t *)v)];
+        int kind = ASRUtils::extract_kind_from_ttype_t(v->m_type);
+        int lanes = info ? 16 / info->lane_size : 1;
+
+        uint32_t prev_cur_loop_nesting_level = cur_loop_nesting_level;
+        cur_loop_nesting_level = nesting_level;
+
+        wasm::emit_b8(m_code_section, m_al, 0x03);  // emit loop start
+        wasm::emit_b8(m_code_section, m_al, 0x40);  // empty block type
+
+        nesting_level++;
+
+        wasm::emit_get_local(m_code_section, m_al, idx);
+        if (lanes > 1) {
+            if (kind == 4) {
+                wasm::emit_i32_const(m_code_section, m_al, lanes - 1);
+                wasm::emit_i32_add(m_code_section, m_al);
+            } else {
+                wasm::emit_i64_const(m_code_section, m_al, lanes - 1);
+                wasm::emit_i64_add(m_code_section, m_al);
+            }
+        }
+        this->visit_expr(*x.m_head.m_end);
+        if (kind == 4) {
+            wasm::emit_i32_le_s(m_code_section, m_al);
+        } else {
+            wasm::emit_i64_le_s(m_code_section, m_al);
+        }
+
+        wasm::emit_b8(m_code_section, m_al, 0x04);  // emit if
+        wasm::emit_b8(m_code_section, m_al, 0x40);  // empty block type
+
+        for (size_t i = 0; i < x.n_body; i++) {
+            if (info) {
+                emit_simd_stmt(*ASR::down_cast<ASR::Assignment_t>(x.m_body[i]),
+                               *info);
+            } else {
+                this->visit_stmt(*x.m_body[i]);
+            }
+        }
+
+        wasm::emit_get_local(m_code_section, m_al, idx);
+        if (kind == 4) {
+            wasm::emit_i32_const(m_code_section, m_al, lanes);
+            wasm::emit_i32_add(m_code_section, m_al);
+        } else {
+            wasm::emit_i64_const(m_code_section, m_al, lanes);
+            wasm::emit_i64_add(m_code_section, m_al);
+        }
+        wasm::emit_set_local(m_code_section, m_al, idx);
+
+        wasm::emit_branch(m_code_section, m_al,
+                          nesting_level - cur_loop_nesting_level);
+        wasm::emit_b8(m_code_section, m_al, 0x05);  // starting of else
+        wasm::emit_expr_end(m_code_section, m_al);  // end if
+
+        nesting_level--;
+        wasm::emit_expr_end(m_code_section, m_al);  // end loop
+        cur_loop_nesting_level = prev_cur_loop_nesting_level;
+    }
+
+    void visit_DoConcurrentLoop(const ASR::DoConcurrentLoop_t &x) {
+        ASR::Variable_t *v = ASRUtils::EXPR2VAR(x.m_head.m_v);
+        uint32_t idx = m_var_name_idx_map[get_hash((ASR::asr_t *)v)];
+        this->visit_expr(*x.m_head.m_start);
+        wasm::emit_set_local(m_code_section, m_al, idx);
+
+        auto simd_loop = m_simd_loop_map.find(get_hash((ASR::asr_t *)&x));
+        if (simd_loop != m_simd_loop_map.end()) {
+            SIMDLoopInfo &info = simd_loop->second;
+            simd_loop_var = (ASR::symbol_t *)v;
+            for (auto &reduction : info.reductions) {
+                emit_simd_reduction(x, reduction, true);
+            }
+            emit_concurrent_loop(x, &info);
+            for (auto &reduction : info.reductions) {
+                emit_simd_reduction(x, reduction, false);
+            }
+        }
+        emit_concurrent_loop(x, nullptr);
+
+        // The loop variable is left at the last iteration, as with do loops
+        wasm::emit_get_local(m_code_section, m_al, idx);
+        if (ASRUtils::extract_kind_from_ttype_t(v->m_type) == 4) {
+            wasm::emit_i32_const(m_code_section, m_al, 1);
+            wasm::emit_i32_sub(m_code_section, m_al);
+        } else {
+            wasm::emit_i64_const(m_code_section, m_al, 1);
+            wasm::emit_i64_sub(m_code_section, m_al);
+        }
+        wasm::emit_set_local(m_code_section, m_al, idx);
+    }
+
     void visit_Exit(const ASR::Exit_t & /* x */) {
         wasm::emit_branch(m_code_section, m_al,
                           nesting_level - cur_loop_nesting_level -
@@ -2120,12 +3041,19 @@ class ASRToWASMVisitor : public ASR::BaseVisitor<ASRToWASMVisitor> {
 
 Result<Vec<uint8_t>> asr_to_wasm_bytes_stream(ASR::TranslationUnit_t &asr,
                                               Allocator &al,
-                                              diag::Diagnostics &diagnostics) {
-    ASRToWASMVisitor v(al, diagnostics);
+                                              diag::Diagnostics &diagnostics,
+                                              CompilerOptions &co,
+                                              bool br_table) {
+    ASRToWASMVisitor v(al, diagnostics, co);
     Vec<uint8_t> wasm_bytes;
 
     LCompilers::PassOptions pass_options;
+    if (v.simd) {
+        pass_loop_vectorise(al, asr, pass_options);
+    }
     pass_replace_do_loops(al, asr, pass_options);
+    pass_options.native_switch = br_table;
+    pass_replace_select_case(al, asr, pass_options);
     pass_array_by_data(al, asr, pass_options);
     pass_options.always_run = true;
     pass_unused_functions(al, asr, pass_options);
@@ -2149,12 +3077,13 @@ Result<Vec<uint8_t>> asr_to_wasm_bytes_stream(ASR::TranslationUnit_t &asr,
 
 Result<int> asr_to_wasm(ASR::TranslationUnit_t &asr, Allocator &al,
                         const std::string &filename, bool time_report,
-                        diag::Diagnostics &diagnostics) {
+                        diag::Diagnostics &diagnostics, CompilerOptions &co) {
     int time_visit_asr = 0;
     int time_save = 0;
 
     auto t1 = std::chrono::high_resolution_clock::now();
-    Result<Vec<uint8_t>> wasm = asr_to_wasm_bytes_stream(asr, al, diagnostics);
+    Result<Vec<uint8_t>> wasm =
+        asr_to_wasm_bytes_stream(asr, al, diagnostics, co);
     auto t2 = std::chrono::high_resolution_clock::now();
     time_visit_asr =
         std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
@@ -2,18 +2,25 @@
 #define LFORTRAN_ASR_TO_WASM_H
 
 #include <libasr/asr.h>
+#include <libasr/utils.h>
 
 namespace LFortran {
 
-// Generates a wasm binary stream from ASR
+// Generates a wasm binary stream from ASR. The loops are vectorised with the
+// SIMD128 instructions if the target has the `simd128` feature
+// (`--target=wasm32+simd128`). The selects with dense cases use a `br_table`
+// unless `br_table` is false (`wasm_to_x86` and `wasm_to_x64` do not
+// translate it)
 Result<Vec<uint8_t>> asr_to_wasm_bytes_stream(ASR::TranslationUnit_t &asr,
                                               Allocator &al,
-                                              diag::Diagnostics &diagnostics);
+                                              diag::Diagnostics &diagnostics,
+                                              CompilerOptions &co,
+                                              bool br_table=true);
 
 // Generates a wasm binary to `filename`
 Result<int> asr_to_wasm(ASR::TranslationUnit_t &asr, Allocator &al,
                         const std::string &filename, bool time_report,
-                        diag::Diagnostics &diagnostics);
+                        diag::Diagnostics &diagnostics, CompilerOptions &co);
 
 }  // namespace LFortran
 
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <fstream>
+#include <mutex>
 
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/ADT/STLExtras.h>
@@ -54,6 +55,7 @@
 #    include <llvm/Support/TargetRegistry.h>
 #endif
 #include <llvm/Support/Host.h>
+#include <llvm/MC/SubtargetFeature.h>
 #include <libasr/codegen/KaleidoscopeJIT.h>
 
 #include <libasr/codegen/evaluator.h>
@@ -135,7 +137,40 @@ float _lfortran_stan(float x);
 
 }
 
-LLVMEvaluator::LLVMEvaluator(const std::string &t)
+// Creates the TargetMachine for the target triple `t` and the CPU `cpu`.
+// An empty `cpu` selects the generic CPU of the target, "native" selects
+// the host CPU together with all its features.
+static llvm::TargetMachine *create_target_machine(const std::string &t,
+        const std::string &cpu)
+{
+    std::string Error;
+    const llvm::Target *target = llvm::TargetRegistry::lookupTarget(t, Error);
+    if (!target) {
+        throw LCompilersException(Error);
+    }
+    std::string CPU = "generic";
+    std::string features = "";
+    if (cpu == "native") {
+        CPU = llvm::sys::getHostCPUName().str();
+        llvm::StringMap<bool> host_features;
+        if (llvm::sys::getHostCPUFeatures(host_features)) {
+            llvm::SubtargetFeatures f;
+            for (auto &feature : host_features) {
+                f.AddFeature(feature.first(), feature.second);
+            }
+            features = f.getString();
+        }
+    } else if (cpu != "") {
+        CPU = cpu;
+    }
+    llvm::TargetOptions opt;
+    llvm::Optional<llvm::Reloc::Model> RM = llvm::Reloc::Model::PIC_;
+    return target->createTargetMachine(t, CPU, features, opt, RM);
+}
+
+// Registers the targets with LLVM, only once per process (the registry is
+// global and the LLVMEvaluators of different threads share it)
+static void initialize_llvm_targets()
 {
     llvm::InitializeNativeTarget();
     llvm::InitializeNativeTargetAsmPrinter();
@@ -162,6 +197,12 @@ LLVMEvaluator::LLVMEvaluator(const std::string &t)
     LLVMInitializeWebAssemblyAsmPrinter();
     LLVMInitializeWebAssemblyAsmParser();
 #endif
+}
+
+LLVMEvaluator::LLVMEvaluator(const std::string &t, const std::string &cpu)
+{
+    static std::once_flag llvm_targets_initialized;
+    std::call_once(llvm_targets_initialized, initialize_llvm_targets);
 
     context = std::make_unique<llvm::LLVMContext>();
 
@@ -170,16 +211,7 @@ LLVMEvaluator::LLVMEvaluator(const std::string &t)
     else
         target_triple = LLVMGetDefaultTargetTriple();
 
-    std::string Error;
-    const llvm::Target *target = llvm::TargetRegistry::lookupTarget(target_triple, Error);
-    if (!target) {
-        throw LCompilersException(Error);
-    }
-    std::string CPU = "generic";
-    std::string features = "";
-    llvm::TargetOptions opt;
-    llvm::Optional<llvm::Reloc::Model> RM = llvm::Reloc::Model::PIC_;
-    TM = target->createTargetMachine(target_triple, CPU, features, opt, RM);
+    TM = create_target_machine(target_triple, cpu);
 
     // For some reason the JIT requires a different TargetMachine
     jit = cantFail(llvm::orc::KaleidoscopeJIT::Create());
@@ -366,7 +398,8 @@ void LLVMEvaluator::create_empty_object_file(const std::string &filename) {
     save_object_file(*module, filename);
 }
 
-void LLVMEvaluator::opt(llvm::Module &m) {
+void LLVMEvaluator::opt(llvm::Module &m, bool profile_generate,
+        const std::string &profile_use) {
     m.setTargetTriple(target_triple);
     m.setDataLayout(TM->createDataLayout());
 
@@ -386,6 +419,22 @@ void LLVMEvaluator::opt(llvm::Module &m) {
     builder.DisableUnrollLoops = false;
     builder.LoopVectorize = true;
     builder.SLPVectorize = true;
+    if (profile_generate || !profile_use.empty()) {
+        auto set_flag = [](const std::string &name) {
+            auto &options = llvm::cl::getRegisteredOptions();
+            auto it = options.find(name);
+            if (it != options.end()) {
+                static_cast<llvm::cl::opt<bool>*>(it->second)->setValue(true);
+            }
+        };
+        // The lpython_instrprof runtime only writes the counters
+        set_flag("disable-vp");
+        // Without the pre-inliner every function keeps its own counts, the
+        // ASR passes use them to find the cold functions
+        set_flag("disable-preinline");
+        builder.EnablePGOInstrGen = profile_generate;
+        builder.PGOInstrUse = profile_use;
+    }
     builder.populateFunctionPassManager(fpm);
     builder.populateModulePassManager(mpm);
 
@@ -438,4 +487,22 @@ std::string LLVMEvaluator::get_default_target_triple()
     return llvm::sys::getDefaultTargetTriple();
 }
 
+// Returns the width (in bits) of the fixed width vector registers of the
+// given target and CPU, as used by the loop vectorizer.
+int LLVMEvaluator::get_vector_width(const std::string &t, const std::string &cpu)
+{
+    std::string triple = (t == "") ? get_default_target_triple() : t;
+    std::unique_ptr<llvm::TargetMachine> tm(create_target_machine(triple, cpu));
+    llvm::LLVMContext context;
+    llvm::Module m("vector_width", context);
+    m.setTargetTriple(triple);
+    m.setDataLayout(tm->createDataLayout());
+    llvm::Function *fn = llvm::Function::Create(
+        llvm::FunctionType::get(llvm::Type::getVoidTy(context), false),
+        llvm::Function::ExternalLinkage, "vector_width", m);
+    llvm::TargetTransformInfo tti = tm->getTargetTransformInfo(*fn);
+    return tti.getRegisterBitWidth(
+        llvm::TargetTransformInfo::RGK_FixedWidthVector).getFixedSize();
+}
+
 } // namespace LFortran
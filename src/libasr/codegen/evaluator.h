@@ -45,7 +45,7 @@ private:
     std::string target_triple;
     llvm::TargetMachine *TM;
 public:
-    LLVMEvaluator(const std::string &t = "");
+    LLVMEvaluator(const std::string &t = "", const std::string &cpu = "");
     ~LLVMEvaluator();
     std::unique_ptr<llvm::Module> parse_module(const std::string &source);
     void add_module(const std::string &source);
@@ -64,12 +64,16 @@ public:
     void save_asm_file(llvm::Module &m, const std::string &filename);
     void save_object_file(llvm::Module &m, const std::string &filename);
     void create_empty_object_file(const std::string &filename);
-    void opt(llvm::Module &m);
+    // Optimizes `m`. With `profile_generate` the code is instrumented to
+    // write an execution profile, `profile_use` is a profile to optimize with.
+    void opt(llvm::Module &m, bool profile_generate=false,
+        const std::string &profile_use="");
     static std::string module_to_string(llvm::Module &m);
     static void print_version_message();
     llvm::LLVMContext &get_context();
     static void print_targets();
     static std::string get_default_target_triple();
+    static int get_vector_width(const std::string &t, const std::string &cpu);
 };
 
 
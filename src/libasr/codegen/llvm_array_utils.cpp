@@ -120,6 +120,18 @@ namespace LFortran {
             return tkr2array.find(asr_type_code) != tkr2array.end();
         }
 
+        bool SimpleCMODescriptor::is_descriptor_type(llvm::Type* type) {
+            if( type == dim_des ) {
+                return true;
+            }
+            for( auto& array_type: tkr2array ) {
+                if( array_type.second.first == type ) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
         llvm::Value* SimpleCMODescriptor::
         convert_to_argument(llvm::Value* tmp, ASR::ttype_t* asr_arg_type,
                             llvm::Type* arg_type, bool data_only) {
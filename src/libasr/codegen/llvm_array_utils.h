@@ -81,6 +81,14 @@ namespace LFortran {
                 virtual
                 bool is_array(ASR::ttype_t* asr_type) = 0;
 
+                /*
+                * Checks whether the given llvm::Type* is one of
+                * the struct types created by this descriptor
+                * (an array or a dimension descriptor).
+                */
+                virtual
+                bool is_descriptor_type(llvm::Type* type) = 0;
+
                 /*
                 * Converts a given array llvm::Value*
                 * into an argument of the specified type.
@@ -303,6 +311,9 @@ namespace LFortran {
                 virtual
                 bool is_array(ASR::ttype_t* asr_type);
 
+                virtual
+                bool is_descriptor_type(llvm::Type* type);
+
                 virtual
                 llvm::Value* convert_to_argument(llvm::Value* tmp,
                     ASR::ttype_t* asr_arg_type, llvm::Type* arg_type,
@@ -1,4 +1,5 @@
 #include <cassert>
+#include <vector>
 
 #include <libasr/alloc.h>
 #include <libasr/containers.h>
@@ -6,7 +7,7 @@
 namespace LFortran {
 namespace wasm {
 
-enum type { i32 = 0x7F, i64 = 0x7E, f32 = 0x7D, f64 = 0x7C };
+enum type { i32 = 0x7F, i64 = 0x7E, f32 = 0x7D, f64 = 0x7C, v128 = 0x7B };
 
 enum mem_align { b8 = 0, b16 = 1, b32 = 2, b64 = 3 };
 
@@ -202,6 +203,12 @@ void encode_section(Vec<uint8_t> &des, Vec<uint8_t> &section_content,
 // function to emit drop instruction (it throws away a single operand on stack)
 void emit_drop(Vec<uint8_t> &code, Allocator &al) { code.push_back(al, 0x1A); }
 
+// function to emit select instruction (it pops a condition and two operands
+// and pushes the first operand if the condition is non-zero, else the second)
+void emit_select(Vec<uint8_t> &code, Allocator &al) {
+    code.push_back(al, 0x1B);
+}
+
 // function to emit get local variable at given index
 void emit_get_local(Vec<uint8_t> &code, Allocator &al, uint32_t idx) {
     code.push_back(al, 0x20);
@@ -774,6 +781,17 @@ void emit_branch_if(Vec<uint8_t> &code, Allocator &al, uint32_t label_idx) {
     emit_u32(code, al, label_idx);
 }
 
+// function to emit br_table instruction, the index on the stack selects the
+// label of `label_idxs` (`default_label_idx` if it is out of range)
+void emit_branch_table(Vec<uint8_t> &code, Allocator &al,
+                       const std::vector<uint32_t> &label_idxs,
+                       uint32_t default_label_idx) {
+    code.push_back(al, 0x0E);
+    emit_u32(code, al, label_idxs.size());
+    for (auto &label_idx : label_idxs) emit_u32(code, al, label_idx);
+    emit_u32(code, al, default_label_idx);
+}
+
 void save_js_glue(std::string filename) {
     std::string js_glue =
         R"(function define_imports(memory, outputBuffer, exit_code, stdout_print) {
@@ -1185,6 +1203,440 @@ void emit_i64_store32(Vec<uint8_t> &code, Allocator &al, uint32_t mem_align,
     emit_u32(code, al, mem_offset);
 }
 
+/**************************** Vector Instructions ****************************/
+
+// function to emit a vector instruction, which is the 0xFD prefix followed by
+// the opcode of the instruction
+void emit_simd_opcode(Vec<uint8_t> &code, Allocator &al, uint32_t opcode) {
+    emit_b8(code, al, 0xFD);
+    emit_u32(code, al, opcode);
+}
+
+// function to emit v128.load instruction
+void emit_v128_load(Vec<uint8_t> &code, Allocator &al, uint32_t mem_align,
+                    uint32_t mem_offset) {
+    emit_simd_opcode(code, al, 0);
+    emit_u32(code, al, mem_align);
+    emit_u32(code, al, mem_offset);
+}
+
+// function to emit v128.load32_splat instruction
+void emit_v128_load32_splat(Vec<uint8_t> &code, Allocator &al,
+                            uint32_t mem_align, uint32_t mem_offset) {
+    emit_simd_opcode(code, al, 9);
+    emit_u32(code, al, mem_align);
+    emit_u32(code, al, mem_offset);
+}
+
+// function to emit v128.load64_splat instruction
+void emit_v128_load64_splat(Vec<uint8_t> &code, Allocator &al,
+                            uint32_t mem_align, uint32_t mem_offset) {
+    emit_simd_opcode(code, al, 10);
+    emit_u32(code, al, mem_align);
+    emit_u32(code, al, mem_offset);
+}
+
+// function to emit v128.store instruction
+void emit_v128_store(Vec<uint8_t> &code, Allocator &al, uint32_t mem_align,
+                     uint32_t mem_offset) {
+    emit_simd_opcode(code, al, 11);
+    emit_u32(code, al, mem_align);
+    emit_u32(code, al, mem_offset);
+}
+
+// function to emit i32x4.extract_lane instruction
+void emit_i32x4_extract_lane(Vec<uint8_t> &code, Allocator &al, uint8_t lane) {
+    emit_simd_opcode(code, al, 27);
+    emit_b8(code, al, lane);
+}
+
+// function to emit i32x4.replace_lane instruction
+void emit_i32x4_replace_lane(Vec<uint8_t> &code, Allocator &al, uint8_t lane) {
+    emit_simd_opcode(code, al, 28);
+    emit_b8(code, al, lane);
+}
+
+// function to emit i64x2.extract_lane instruction
+void emit_i64x2_extract_lane(Vec<uint8_t> &code, Allocator &al, uint8_t lane) {
+    emit_simd_opcode(code, al, 29);
+    emit_b8(code, al, lane);
+}
+
+// function to emit i64x2.replace_lane instruction
+void emit_i64x2_replace_lane(Vec<uint8_t> &code, Allocator &al, uint8_t lane) {
+    emit_simd_opcode(code, al, 30);
+    emit_b8(code, al, lane);
+}
+
+// function to emit f32x4.extract_lane instruction
+void emit_f32x4_extract_lane(Vec<uint8_t> &code, Allocator &al, uint8_t lane) {
+    emit_simd_opcode(code, al, 31);
+    emit_b8(code, al, lane);
+}
+
+// function to emit f32x4.replace_lane instruction
+void emit_f32x4_replace_lane(Vec<uint8_t> &code, Allocator &al, uint8_t lane) {
+    emit_simd_opcode(code, al, 32);
+    emit_b8(code, al, lane);
+}
+
+// function to emit f64x2.extract_lane instruction
+void emit_f64x2_extract_lane(Vec<uint8_t> &code, Allocator &al, uint8_t lane) {
+    emit_simd_opcode(code, al, 33);
+    emit_b8(code, al, lane);
+}
+
+// function to emit f64x2.replace_lane instruction
+void emit_f64x2_replace_lane(Vec<uint8_t> &code, Allocator &al, uint8_t lane) {
+    emit_simd_opcode(code, al, 34);
+    emit_b8(code, al, lane);
+}
+
+// function to emit i32x4.splat instruction
+void emit_i32x4_splat(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 17);
+}
+
+// function to emit i64x2.splat instruction
+void emit_i64x2_splat(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 18);
+}
+
+// function to emit f32x4.splat instruction
+void emit_f32x4_splat(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 19);
+}
+
+// function to emit f64x2.splat instruction
+void emit_f64x2_splat(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 20);
+}
+
+// function to emit v128.not instruction
+void emit_v128_not(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 77);
+}
+
+// function to emit v128.and instruction
+void emit_v128_and(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 78);
+}
+
+// function to emit v128.andnot instruction
+void emit_v128_andnot(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 79);
+}
+
+// function to emit v128.or instruction
+void emit_v128_or(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 80);
+}
+
+// function to emit v128.xor instruction
+void emit_v128_xor(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 81);
+}
+
+// function to emit v128.bitselect instruction
+void emit_v128_bitselect(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 82);
+}
+
+// function to emit v128.any_true instruction
+void emit_v128_any_true(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 83);
+}
+
+// function to emit i32x4.eq instruction
+void emit_i32x4_eq(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 55);
+}
+
+// function to emit i32x4.ne instruction
+void emit_i32x4_ne(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 56);
+}
+
+// function to emit i32x4.lt_s instruction
+void emit_i32x4_lt_s(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 57);
+}
+
+// function to emit i32x4.gt_s instruction
+void emit_i32x4_gt_s(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 59);
+}
+
+// function to emit i32x4.le_s instruction
+void emit_i32x4_le_s(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 61);
+}
+
+// function to emit i32x4.ge_s instruction
+void emit_i32x4_ge_s(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 63);
+}
+
+// function to emit i64x2.eq instruction
+void emit_i64x2_eq(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 214);
+}
+
+// function to emit i64x2.ne instruction
+void emit_i64x2_ne(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 215);
+}
+
+// function to emit i64x2.lt_s instruction
+void emit_i64x2_lt_s(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 216);
+}
+
+// function to emit i64x2.gt_s instruction
+void emit_i64x2_gt_s(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 217);
+}
+
+// function to emit i64x2.le_s instruction
+void emit_i64x2_le_s(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 218);
+}
+
+// function to emit i64x2.ge_s instruction
+void emit_i64x2_ge_s(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 219);
+}
+
+// function to emit f32x4.eq instruction
+void emit_f32x4_eq(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 65);
+}
+
+// function to emit f32x4.ne instruction
+void emit_f32x4_ne(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 66);
+}
+
+// function to emit f32x4.lt instruction
+void emit_f32x4_lt(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 67);
+}
+
+// function to emit f32x4.gt instruction
+void emit_f32x4_gt(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 68);
+}
+
+// function to emit f32x4.le instruction
+void emit_f32x4_le(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 69);
+}
+
+// function to emit f32x4.ge instruction
+void emit_f32x4_ge(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 70);
+}
+
+// function to emit f64x2.eq instruction
+void emit_f64x2_eq(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 71);
+}
+
+// function to emit f64x2.ne instruction
+void emit_f64x2_ne(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 72);
+}
+
+// function to emit f64x2.lt instruction
+void emit_f64x2_lt(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 73);
+}
+
+// function to emit f64x2.gt instruction
+void emit_f64x2_gt(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 74);
+}
+
+// function to emit f64x2.le instruction
+void emit_f64x2_le(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 75);
+}
+
+// function to emit f64x2.ge instruction
+void emit_f64x2_ge(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 76);
+}
+
+// function to emit i32x4.abs instruction
+void emit_i32x4_abs(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 160);
+}
+
+// function to emit i32x4.neg instruction
+void emit_i32x4_neg(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 161);
+}
+
+// function to emit i32x4.add instruction
+void emit_i32x4_add(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 174);
+}
+
+// function to emit i32x4.sub instruction
+void emit_i32x4_sub(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 177);
+}
+
+// function to emit i32x4.mul instruction
+void emit_i32x4_mul(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 181);
+}
+
+// function to emit i64x2.abs instruction
+void emit_i64x2_abs(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 192);
+}
+
+// function to emit i64x2.neg instruction
+void emit_i64x2_neg(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 193);
+}
+
+// function to emit i64x2.add instruction
+void emit_i64x2_add(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 206);
+}
+
+// function to emit i64x2.sub instruction
+void emit_i64x2_sub(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 209);
+}
+
+// function to emit i64x2.mul instruction
+void emit_i64x2_mul(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 213);
+}
+
+// function to emit f32x4.abs instruction
+void emit_f32x4_abs(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 224);
+}
+
+// function to emit f32x4.neg instruction
+void emit_f32x4_neg(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 225);
+}
+
+// function to emit f32x4.sqrt instruction
+void emit_f32x4_sqrt(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 227);
+}
+
+// function to emit f32x4.add instruction
+void emit_f32x4_add(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 228);
+}
+
+// function to emit f32x4.sub instruction
+void emit_f32x4_sub(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 229);
+}
+
+// function to emit f32x4.mul instruction
+void emit_f32x4_mul(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 230);
+}
+
+// function to emit f32x4.div instruction
+void emit_f32x4_div(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 231);
+}
+
+// function to emit f32x4.min instruction
+void emit_f32x4_min(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 232);
+}
+
+// function to emit f32x4.max instruction
+void emit_f32x4_max(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 233);
+}
+
+// function to emit f64x2.abs instruction
+void emit_f64x2_abs(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 236);
+}
+
+// function to emit f64x2.neg instruction
+void emit_f64x2_neg(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 237);
+}
+
+// function to emit f64x2.sqrt instruction
+void emit_f64x2_sqrt(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 239);
+}
+
+// function to emit f64x2.add instruction
+void emit_f64x2_add(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 240);
+}
+
+// function to emit f64x2.sub instruction
+void emit_f64x2_sub(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 241);
+}
+
+// function to emit f64x2.mul instruction
+void emit_f64x2_mul(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 242);
+}
+
+// function to emit f64x2.div instruction
+void emit_f64x2_div(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 243);
+}
+
+// function to emit f64x2.min instruction
+void emit_f64x2_min(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 244);
+}
+
+// function to emit f64x2.max instruction
+void emit_f64x2_max(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 245);
+}
+
+// function to emit i32x4.trunc_sat_f32x4_s instruction
+void emit_i32x4_trunc_sat_f32x4_s(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 248);
+}
+
+// function to emit f32x4.convert_i32x4_s instruction
+void emit_f32x4_convert_i32x4_s(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 250);
+}
+
+// function to emit i32x4.trunc_sat_f64x2_s_zero instruction
+void emit_i32x4_trunc_sat_f64x2_s_zero(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 252);
+}
+
+// function to emit f64x2.convert_low_i32x4_s instruction
+void emit_f64x2_convert_low_i32x4_s(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 254);
+}
+
+// function to emit f32x4.demote_f64x2_zero instruction
+void emit_f32x4_demote_f64x2_zero(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 94);
+}
+
+// function to emit f64x2.promote_low_f32x4 instruction
+void emit_f64x2_promote_low_f32x4(Vec<uint8_t> &code, Allocator &al) {
+    emit_simd_opcode(code, al, 95);
+}
+
 }  // namespace wasm
 
 }  // namespace LFortran
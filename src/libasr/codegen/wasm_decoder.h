@@ -66,7 +66,8 @@ class WASMDecoder {
     WASMDecoder(Allocator &al, diag::Diagnostics &diagonostics)
         : al(al), diag(diagonostics) {
         var_type_to_string = {
-            {0x7F, "i32"}, {0x7E, "i64"}, {0x7D, "f32"}, {0x7C, "f64"}};
+            {0x7F, "i32"}, {0x7E, "i64"}, {0x7D, "f32"}, {0x7C, "f64"},
+            {0x7B, "v128"}};
         kind_to_string = {
             {0x00, "func"}, {0x01, "table"}, {0x02, "mem"}, {0x03, "global"}};
 
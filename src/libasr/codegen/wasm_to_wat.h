@@ -26,7 +26,16 @@ class WATVisitor : public BaseWASMVisitor<WATVisitor> {
     void visit_BrIf(uint32_t label_index) {
         src += indent + "br_if " + std::to_string(label_index);
     }
+    void visit_BrTable(std::vector<uint32_t> label_indices,
+                       uint32_t default_label_index) {
+        src += indent + "br_table";
+        for (auto &label_index : label_indices) {
+            src += " " + std::to_string(label_index);
+        }
+        src += " " + std::to_string(default_label_index);
+    }
     void visit_Drop() { src += indent + "drop"; }
+    void visit_Select() { src += indent + "select"; }
     void visit_LocalGet(uint32_t localidx) {
         src += indent + "local.get " + std::to_string(localidx);
     }
@@ -47,6 +56,16 @@ class WATVisitor : public BaseWASMVisitor<WATVisitor> {
     void visit_Else() {
         src += indent.substr(0, indent.length() - 4U) + "else";
     }
+    void visit_Block() {
+        src += indent + "block";
+        {
+            WATVisitor v = WATVisitor(code, offset, "", indent + "    ");
+            v.decode_instructions();
+            src += v.src;
+            offset = v.offset;
+        }
+        src += indent + "end";
+    }
     void visit_Loop() {
         src += indent + "loop";
         {
@@ -279,6 +298,129 @@ class WATVisitor : public BaseWASMVisitor<WATVisitor> {
         src += indent + "i64.store32 offset=" + std::to_string(mem_offset) +
                " align=" + std::to_string(1U << mem_align);
     }
+
+    void visit_I32x4Splat() { src += indent + "i32x4.splat"; }
+    void visit_I64x2Splat() { src += indent + "i64x2.splat"; }
+    void visit_F32x4Splat() { src += indent + "f32x4.splat"; }
+    void visit_F64x2Splat() { src += indent + "f64x2.splat"; }
+    void visit_V128Not() { src += indent + "v128.not"; }
+    void visit_V128And() { src += indent + "v128.and"; }
+    void visit_V128Andnot() { src += indent + "v128.andnot"; }
+    void visit_V128Or() { src += indent + "v128.or"; }
+    void visit_V128Xor() { src += indent + "v128.xor"; }
+    void visit_V128Bitselect() { src += indent + "v128.bitselect"; }
+    void visit_V128AnyTrue() { src += indent + "v128.any_true"; }
+    void visit_I32x4Eq() { src += indent + "i32x4.eq"; }
+    void visit_I32x4Ne() { src += indent + "i32x4.ne"; }
+    void visit_I32x4LtS() { src += indent + "i32x4.lt_s"; }
+    void visit_I32x4GtS() { src += indent + "i32x4.gt_s"; }
+    void visit_I32x4LeS() { src += indent + "i32x4.le_s"; }
+    void visit_I32x4GeS() { src += indent + "i32x4.ge_s"; }
+    void visit_I64x2Eq() { src += indent + "i64x2.eq"; }
+    void visit_I64x2Ne() { src += indent + "i64x2.ne"; }
+    void visit_I64x2LtS() { src += indent + "i64x2.lt_s"; }
+    void visit_I64x2GtS() { src += indent + "i64x2.gt_s"; }
+    void visit_I64x2LeS() { src += indent + "i64x2.le_s"; }
+    void visit_I64x2GeS() { src += indent + "i64x2.ge_s"; }
+    void visit_F32x4Eq() { src += indent + "f32x4.eq"; }
+    void visit_F32x4Ne() { src += indent + "f32x4.ne"; }
+    void visit_F32x4Lt() { src += indent + "f32x4.lt"; }
+    void visit_F32x4Gt() { src += indent + "f32x4.gt"; }
+    void visit_F32x4Le() { src += indent + "f32x4.le"; }
+    void visit_F32x4Ge() { src += indent + "f32x4.ge"; }
+    void visit_F64x2Eq() { src += indent + "f64x2.eq"; }
+    void visit_F64x2Ne() { src += indent + "f64x2.ne"; }
+    void visit_F64x2Lt() { src += indent + "f64x2.lt"; }
+    void visit_F64x2Gt() { src += indent + "f64x2.gt"; }
+    void visit_F64x2Le() { src += indent + "f64x2.le"; }
+    void visit_F64x2Ge() { src += indent + "f64x2.ge"; }
+    void visit_I32x4Abs() { src += indent + "i32x4.abs"; }
+    void visit_I32x4Neg() { src += indent + "i32x4.neg"; }
+    void visit_I32x4Add() { src += indent + "i32x4.add"; }
+    void visit_I32x4Sub() { src += indent + "i32x4.sub"; }
+    void visit_I32x4Mul() { src += indent + "i32x4.mul"; }
+    void visit_I64x2Abs() { src += indent + "i64x2.abs"; }
+    void visit_I64x2Neg() { src += indent + "i64x2.neg"; }
+    void visit_I64x2Add() { src += indent + "i64x2.add"; }
+    void visit_I64x2Sub() { src += indent + "i64x2.sub"; }
+    void visit_I64x2Mul() { src += indent + "i64x2.mul"; }
+    void visit_F32x4Abs() { src += indent + "f32x4.abs"; }
+    void visit_F32x4Neg() { src += indent + "f32x4.neg"; }
+    void visit_F32x4Sqrt() { src += indent + "f32x4.sqrt"; }
+    void visit_F32x4Add() { src += indent + "f32x4.add"; }
+    void visit_F32x4Sub() { src += indent + "f32x4.sub"; }
+    void visit_F32x4Mul() { src += indent + "f32x4.mul"; }
+    void visit_F32x4Div() { src += indent + "f32x4.div"; }
+    void visit_F32x4Min() { src += indent + "f32x4.min"; }
+    void visit_F32x4Max() { src += indent + "f32x4.max"; }
+    void visit_F64x2Abs() { src += indent + "f64x2.abs"; }
+    void visit_F64x2Neg() { src += indent + "f64x2.neg"; }
+    void visit_F64x2Sqrt() { src += indent + "f64x2.sqrt"; }
+    void visit_F64x2Add() { src += indent + "f64x2.add"; }
+    void visit_F64x2Sub() { src += indent + "f64x2.sub"; }
+    void visit_F64x2Mul() { src += indent + "f64x2.mul"; }
+    void visit_F64x2Div() { src += indent + "f64x2.div"; }
+    void visit_F64x2Min() { src += indent + "f64x2.min"; }
+    void visit_F64x2Max() { src += indent + "f64x2.max"; }
+    void visit_I32x4TruncSatF32x4S() {
+        src += indent + "i32x4.trunc_sat_f32x4_s";
+    }
+    void visit_F32x4ConvertI32x4S() { src += indent + "f32x4.convert_i32x4_s"; }
+    void visit_I32x4TruncSatF64x2SZero() {
+        src += indent + "i32x4.trunc_sat_f64x2_s_zero";
+    }
+    void visit_F64x2ConvertLowI32x4S() {
+        src += indent + "f64x2.convert_low_i32x4_s";
+    }
+    void visit_F32x4DemoteF64x2Zero() {
+        src += indent + "f32x4.demote_f64x2_zero";
+    }
+    void visit_F64x2PromoteLowF32x4() {
+        src += indent + "f64x2.promote_low_f32x4";
+    }
+
+    void visit_I32x4ExtractLane(uint8_t lane) {
+        src += indent + "i32x4.extract_lane " + std::to_string(lane);
+    }
+    void visit_I32x4ReplaceLane(uint8_t lane) {
+        src += indent + "i32x4.replace_lane " + std::to_string(lane);
+    }
+    void visit_I64x2ExtractLane(uint8_t lane) {
+        src += indent + "i64x2.extract_lane " + std::to_string(lane);
+    }
+    void visit_I64x2ReplaceLane(uint8_t lane) {
+        src += indent + "i64x2.replace_lane " + std::to_string(lane);
+    }
+    void visit_F32x4ExtractLane(uint8_t lane) {
+        src += indent + "f32x4.extract_lane " + std::to_string(lane);
+    }
+    void visit_F32x4ReplaceLane(uint8_t lane) {
+        src += indent + "f32x4.replace_lane " + std::to_string(lane);
+    }
+    void visit_F64x2ExtractLane(uint8_t lane) {
+        src += indent + "f64x2.extract_lane " + std::to_string(lane);
+    }
+    void visit_F64x2ReplaceLane(uint8_t lane) {
+        src += indent + "f64x2.replace_lane " + std::to_string(lane);
+    }
+    void visit_V128Load(uint32_t mem_align, uint32_t mem_offset) {
+        src += indent + "v128.load offset=" + std::to_string(mem_offset) +
+               " align=" + std::to_string(1U << mem_align);
+    }
+    void visit_V128Load32Splat(uint32_t mem_align, uint32_t mem_offset) {
+        src += indent + "v128.load32_splat offset=" +
+               std::to_string(mem_offset) +
+               " align=" + std::to_string(1U << mem_align);
+    }
+    void visit_V128Load64Splat(uint32_t mem_align, uint32_t mem_offset) {
+        src += indent + "v128.load64_splat offset=" +
+               std::to_string(mem_offset) +
+               " align=" + std::to_string(1U << mem_align);
+    }
+    void visit_V128Store(uint32_t mem_align, uint32_t mem_offset) {
+        src += indent + "v128.store offset=" + std::to_string(mem_offset) +
+               " align=" + std::to_string(1U << mem_align);
+    }
 };
 
 }  // namespace WASM_INSTS_VISITOR
@@ -99,6 +99,15 @@ int64_t read_i64(Vec<uint8_t> &code, uint32_t &offset) {
     return decode_leb128_i64(code, offset);
 }
 
+std::vector<uint32_t> read_vec_u32(Vec<uint8_t> &code, uint32_t &offset) {
+    uint32_t n = read_u32(code, offset);
+    std::vector<uint32_t> v(n);
+    for (uint32_t i = 0; i < n; i++) {
+        v[i] = read_u32(code, offset);
+    }
+    return v;
+}
+
 void hexdump(void *ptr, int buflen) {
     unsigned char *buf = (unsigned char *)ptr;
     int i, j;
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <unordered_map>
+#include <vector>
 
 #include <libasr/alloc.h>
 #include <libasr/containers.h>
@@ -64,6 +65,8 @@ int32_t read_i32(Vec<uint8_t> &code, uint32_t &offset);
 
 int64_t read_i64(Vec<uint8_t> &code, uint32_t &offset);
 
+std::vector<uint32_t> read_vec_u32(Vec<uint8_t> &code, uint32_t &offset);
+
 void hexdump(void *ptr, int buflen);
 
 }  // namespace wasm
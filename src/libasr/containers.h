@@ -54,7 +54,7 @@ struct Vec {
         if (max == 0) max++;
         LFORTRAN_ASSERT(max > 0)
         this->max = max;
-        p = al.allocate<T>(max);
+        p = al.allocate_reuse<T>(max);
 #ifdef WITH_LFORTRAN_ASSERT
         reserve_called = vec_called_const;
 #endif
@@ -68,8 +68,11 @@ struct Vec {
         LFORTRAN_ASSERT(reserve_called == vec_called_const);
         if (n == max) {
             size_t max2 = 2*max;
-            T* p2 = al.allocate<T>(max2);
+            T* p2 = al.allocate_reuse<T>(max2);
             std::memcpy(p2, p, sizeof(T) * max);
+            // The old buffer is not used any more, let the allocator hand
+            // it out again
+            al.recycle(p, sizeof(T) * max);
             p = p2;
             max = max2;
         }
@@ -0,0 +1,508 @@
+#include <libasr/asr.h>
+#include <libasr/containers.h>
+#include <libasr/exception.h>
+#include <libasr/asr_utils.h>
+#include <libasr/asr_verify.h>
+#include <libasr/pass/array_kernels.h>
+#include <libasr/pass/pass_utils.h>
+
+#include <vector>
+#include <utility>
+
+
+namespace LFortran {
+
+using ASR::down_cast;
+using ASR::is_a;
+
+/*
+
+This ASR pass replaces loops which compute a sum, a dot product, a matrix
+product or a transpose of arrays with a call to the corresponding kernel
+of the runtime library. The kernels are blocked and vectorized and they can
+use an external CBLAS (see WITH_CBLAS).
+
+Converts:
+
+    for i in range(n):
+        s = s + x[i]*y[i]
+
+to:
+
+    s = s + _lfortran_vddot(n, c_loc(x[0]), c_loc(y[0]))
+
+and:
+
+    for i in range(m):
+        for j in range(n):
+            for k in range(p):
+                c[i, j] = c[i, j] + a[i, k]*b[k, j]
+
+to:
+
+    _lfortran_vdgemm(m, n, p, c_loc(a[0, 0]), size(a, 1),
+        c_loc(b[0, 0]), size(b, 1), c_loc(c[0, 0]), size(c, 1))
+
+The kernels add up the terms in a different order than the loops, so this
+pass is only applied with optimizations enabled. The matrix kernels expect
+the column-major order in which the LLVM backend stores arrays.
+
+*/
+
+class SymbolUsageVisitor : public ASR::BaseWalkVisitor<SymbolUsageVisitor>
+{
+public:
+    std::vector<ASR::symbol_t*>& symbols;
+    bool found;
+
+    SymbolUsageVisitor(std::vector<ASR::symbol_t*>& symbols_):
+        symbols(symbols_), found(false) {}
+
+    void visit_Var(const ASR::Var_t& x) {
+        for( ASR::symbol_t* sym: symbols ) {
+            found = found || x.m_v == sym;
+        }
+    }
+};
+
+class ArrayKernelsVisitor : public PassUtils::SkipOptimizationFunctionVisitor<ArrayKernelsVisitor>
+{
+private:
+    ASR::TranslationUnit_t &unit;
+
+public:
+    ArrayKernelsVisitor(Allocator &al_, ASR::TranslationUnit_t &unit_):
+        SkipOptimizationFunctionVisitor(al_), unit(unit_)
+    {
+        pass_result.reserve(al, 1);
+    }
+
+    ASR::symbol_t* get_loop_var(const ASR::DoLoop_t& x) {
+        return down_cast<ASR::Var_t>(x.m_head.m_v)->m_v;
+    }
+
+    bool is_unit_stride_loop(const ASR::DoLoop_t& x) {
+        if( !x.m_head.m_v || !is_a<ASR::Var_t>(*x.m_head.m_v) ||
+            !x.m_head.m_start || !x.m_head.m_end ) {
+            return false;
+        }
+        if( !x.m_head.m_increment ) {
+            return true;
+        }
+        ASR::expr_t* increment = ASRUtils::expr_value(x.m_head.m_increment);
+        int64_t increment_int = 0;
+        return increment && ASRUtils::is_value_constant(increment) &&
+               ASRUtils::extract_value(increment, increment_int) &&
+               increment_int == 1;
+    }
+
+    bool uses_symbols(ASR::expr_t* x, std::vector<ASR::symbol_t*>& symbols) {
+        SymbolUsageVisitor v(symbols);
+        v.visit_expr(*x);
+        return v.found;
+    }
+
+    // Returns the array of `x` if it is an element `array[idx[0], idx[1], ...]`
+    // of a real array with exactly the given index variables
+    ASR::expr_t* get_indexed_array(ASR::expr_t* x,
+        const std::vector<ASR::symbol_t*>& idx) {
+        if( !is_a<ASR::ArrayItem_t>(*x) ) {
+            return nullptr;
+        }
+        ASR::ArrayItem_t* item = down_cast<ASR::ArrayItem_t>(x);
+        if( item->n_args != idx.size() || !is_a<ASR::Var_t>(*item->m_v) ||
+            !is_a<ASR::Variable_t>(*down_cast<ASR::Var_t>(item->m_v)->m_v) ||
+            is_a<ASR::Pointer_t>(*ASRUtils::expr_type(item->m_v)) ||
+            ASRUtils::expr_abi(item->m_v) != ASR::abiType::Source ||
+            !ASRUtils::is_real(*item->m_type) ) {
+            return nullptr;
+        }
+        for( size_t i = 0; i < item->n_args; i++ ) {
+            ASR::expr_t* index = item->m_args[i].m_right;
+            if( item->m_args[i].m_left || item->m_args[i].m_step || !index ||
+                !is_a<ASR::Var_t>(*index) ||
+                down_cast<ASR::Var_t>(index)->m_v != idx[i] ) {
+                return nullptr;
+            }
+        }
+        return item->m_v;
+    }
+
+    bool same_array(ASR::expr_t* a, ASR::expr_t* b) {
+        return down_cast<ASR::Var_t>(a)->m_v == down_cast<ASR::Var_t>(b)->m_v;
+    }
+
+    int get_kind(ASR::expr_t* x) {
+        return ASRUtils::extract_kind_from_ttype_t(ASRUtils::expr_type(x));
+    }
+
+    // Returns the declaration of a kernel of the runtime library, which takes
+    // the arguments `arg_types` by value
+    ASR::symbol_t* get_kernel(const std::string& name,
+        const std::vector<ASR::ttype_t*>& arg_types, ASR::ttype_t* return_type) {
+        SymbolTable* global_scope = unit.m_global_scope;
+        ASR::symbol_t* kernel = global_scope->get_symbol(name);
+        if( kernel ) {
+            return is_a<ASR::Function_t>(*kernel) ? kernel : nullptr;
+        }
+        const Location& loc = unit.base.base.loc;
+        SymbolTable* kernel_symtab = al.make_new<SymbolTable>(global_scope);
+        Vec<ASR::expr_t*> args;
+        args.reserve(al, arg_types.size());
+        for( size_t i = 0; i < arg_types.size(); i++ ) {
+            std::string arg_name = "arg" + std::to_string(i);
+            ASR::symbol_t* arg = ASR::down_cast<ASR::symbol_t>(ASR::make_Variable_t(al,
+                loc, kernel_symtab, s2c(al, arg_name), nullptr, 0,
+                ASR::intentType::In, nullptr, nullptr, ASR::storage_typeType::Default,
+                arg_types[i], ASR::abiType::BindC, ASR::accessType::Public,
+                ASR::presenceType::Required, true));
+            kernel_symtab->add_symbol(arg_name, arg);
+            args.push_back(al, ASRUtils::EXPR(ASR::make_Var_t(al, loc, arg)));
+        }
+        ASR::expr_t* return_var = nullptr;
+        if( return_type ) {
+            std::string return_var_name = "_lpython_return_variable";
+            ASR::symbol_t* return_sym = ASR::down_cast<ASR::symbol_t>(ASR::make_Variable_t(al,
+                loc, kernel_symtab, s2c(al, return_var_name), nullptr, 0,
+                ASR::intentType::ReturnVar, nullptr, nullptr, ASR::storage_typeType::Default,
+                return_type, ASR::abiType::BindC, ASR::accessType::Public,
+                ASR::presenceType::Required, false));
+            kernel_symtab->add_symbol(return_var_name, return_sym);
+            return_var = ASRUtils::EXPR(ASR::make_Var_t(al, loc, return_sym));
+        }
+        kernel = ASR::down_cast<ASR::symbol_t>(ASR::make_Function_t(al, loc,
+            kernel_symtab, s2c(al, name), nullptr, 0, args.p, args.size(),
+            nullptr, 0, return_var, ASR::abiType::BindC, ASR::accessType::Public,
+            ASR::deftypeType::Interface, nullptr, false, false, false, false,
+            false, nullptr, 0, nullptr, 0, false));
+        global_scope->add_symbol(name, kernel);
+        return kernel;
+    }
+
+    std::string get_kernel_name(const std::string& name, int kind) {
+        return std::string("_lfortran_v") + (kind == 4 ? "s" : "d") + name;
+    }
+
+    ASR::ttype_t* int64_type(const Location& loc) {
+        return ASRUtils::TYPE(ASR::make_Integer_t(al, loc, 8, nullptr, 0));
+    }
+
+    ASR::ttype_t* cptr_type(const Location& loc) {
+        return ASRUtils::TYPE(ASR::make_CPtr_t(al, loc));
+    }
+
+    ASR::expr_t* to_int64(ASR::expr_t* x) {
+        ASR::ttype_t* type = ASRUtils::expr_type(x);
+        if( ASRUtils::extract_kind_from_ttype_t(type) == 8 ) {
+            return x;
+        }
+        return ASRUtils::EXPR(ASR::make_Cast_t(al, x->base.loc, x,
+            ASR::cast_kindType::IntegerToInteger, int64_type(x->base.loc), nullptr));
+    }
+
+    // The number of iterations, end - start + 1
+    ASR::expr_t* get_trip_count(const ASR::DoLoop_t& x) {
+        const Location& loc = x.base.base.loc;
+        ASR::ttype_t* type = ASRUtils::expr_type(x.m_head.m_v);
+        ASR::expr_t* one = ASRUtils::EXPR(ASR::make_IntegerConstant_t(al, loc, 1, type));
+        ASR::expr_t* length = ASRUtils::EXPR(ASR::make_IntegerBinOp_t(al, loc,
+            x.m_head.m_end, ASR::binopType::Sub, x.m_head.m_start, type, nullptr));
+        length = ASRUtils::EXPR(ASR::make_IntegerBinOp_t(al, loc, length,
+            ASR::binopType::Add, one, type, nullptr));
+        return to_int64(length);
+    }
+
+    // The address of the element `array[idx[0], idx[1], ...]`
+    ASR::expr_t* get_element_address(ASR::expr_t* array,
+        const std::vector<ASR::expr_t*>& idx) {
+        const Location& loc = array->base.loc;
+        Vec<ASR::expr_t*> idx_vec;
+        idx_vec.reserve(al, idx.size());
+        for( ASR::expr_t* i: idx ) {
+            idx_vec.push_back(al, i);
+        }
+        ASR::expr_t* element = PassUtils::create_array_ref(array, idx_vec, al);
+        ASR::ttype_t* pointer_type = ASRUtils::TYPE(ASR::make_Pointer_t(al, loc,
+            ASRUtils::expr_type(element)));
+        ASR::expr_t* pointer = ASRUtils::EXPR(ASR::make_GetPointer_t(al, loc,
+            element, pointer_type, nullptr));
+        return ASRUtils::EXPR(ASR::make_PointerToCPtr_t(al, loc, pointer,
+            cptr_type(loc), nullptr));
+    }
+
+    // size(array, 1), the distance between two columns of `array`
+    ASR::expr_t* get_leading_dimension(ASR::expr_t* array) {
+        const Location& loc = array->base.loc;
+        ASR::expr_t* dim = ASRUtils::EXPR(ASR::make_IntegerConstant_t(al, loc, 1,
+            ASRUtils::TYPE(ASR::make_Integer_t(al, loc, 4, nullptr, 0))));
+        return ASRUtils::EXPR(ASR::make_ArraySize_t(al, loc, array, dim,
+            int64_type(loc), nullptr));
+    }
+
+    Vec<ASR::call_arg_t> make_call_args(const std::vector<ASR::expr_t*>& values) {
+        Vec<ASR::call_arg_t> args;
+        args.reserve(al, values.size());
+        for( ASR::expr_t* value: values ) {
+            ASR::call_arg_t arg;
+            arg.loc = value->base.loc;
+            arg.m_value = value;
+            args.push_back(al, arg);
+        }
+        return args;
+    }
+
+    /*
+        s = s + x[i]      ->  s = s + _lfortran_vdsum(n, c_loc(x[start]))
+        s = s + x[i]*y[i] ->  s = s + _lfortran_vddot(n, c_loc(x[start]), c_loc(y[start]))
+    */
+    bool replace_reduction(const ASR::DoLoop_t& x) {
+        if( x.n_body != 1 || !is_a<ASR::Assignment_t>(*x.m_body[0]) ) {
+            return false;
+        }
+        ASR::Assignment_t* assignment = down_cast<ASR::Assignment_t>(x.m_body[0]);
+        ASR::expr_t* target = assignment->m_target;
+        if( !is_a<ASR::Var_t>(*target) ||
+            !ASRUtils::is_real(*ASRUtils::expr_type(target)) ||
+            ASRUtils::is_array(ASRUtils::expr_type(target)) ||
+            !is_a<ASR::RealBinOp_t>(*assignment->m_value) ) {
+            return false;
+        }
+        ASR::RealBinOp_t* sum = down_cast<ASR::RealBinOp_t>(assignment->m_value);
+        if( sum->m_op != ASR::binopType::Add ) {
+            return false;
+        }
+        ASR::symbol_t* accumulator = down_cast<ASR::Var_t>(target)->m_v;
+        ASR::expr_t* term = nullptr;
+        if( is_a<ASR::Var_t>(*sum->m_left) &&
+            down_cast<ASR::Var_t>(sum->m_left)->m_v == accumulator ) {
+            term = sum->m_right;
+        } else if( is_a<ASR::Var_t>(*sum->m_right) &&
+                   down_cast<ASR::Var_t>(sum->m_right)->m_v == accumulator ) {
+            term = sum->m_left;
+        } else {
+            return false;
+        }
+
+        std::vector<ASR::symbol_t*> idx = {get_loop_var(x)};
+        std::vector<ASR::expr_t*> arrays;
+        std::string name;
+        if( ASR::expr_t* array = get_indexed_array(term, idx) ) {
+            arrays.push_back(array);
+            name = "sum";
+        } else if( is_a<ASR::RealBinOp_t>(*term) &&
+                   down_cast<ASR::RealBinOp_t>(term)->m_op == ASR::binopType::Mul ) {
+            ASR::RealBinOp_t* product = down_cast<ASR::RealBinOp_t>(term);
+            ASR::expr_t* array0 = get_indexed_array(product->m_left, idx);
+            ASR::expr_t* array1 = get_indexed_array(product->m_right, idx);
+            if( !array0 || !array1 ) {
+                return false;
+            }
+            arrays.push_back(array0);
+            arrays.push_back(array1);
+            name = "dot";
+        } else {
+            return false;
+        }
+        int kind = get_kind(target);
+        for( ASR::expr_t* array: arrays ) {
+            if( get_kind(array) != kind ||
+                ASRUtils::extract_n_dims_from_ttype(ASRUtils::expr_type(array)) != 1 ) {
+                return false;
+            }
+        }
+
+        const Location& loc = x.base.base.loc;
+        std::vector<ASR::ttype_t*> arg_types = {int64_type(loc)};
+        std::vector<ASR::expr_t*> arg_values = {get_trip_count(x)};
+        for( ASR::expr_t* array: arrays ) {
+            arg_types.push_back(cptr_type(loc));
+            arg_values.push_back(get_element_address(array, {x.m_head.m_start}));
+        }
+        ASR::ttype_t* type = ASRUtils::expr_type(target);
+        ASR::symbol_t* kernel = get_kernel(get_kernel_name(name, kind), arg_types, type);
+        if( !kernel ) {
+            return false;
+        }
+        Vec<ASR::call_arg_t> args = make_call_args(arg_values);
+        ASR::expr_t* call = ASRUtils::EXPR(ASR::make_FunctionCall_t(al, loc, kernel,
+            nullptr, args.p, args.size(), type, nullptr, nullptr));
+        ASR::expr_t* value = ASRUtils::EXPR(ASR::make_RealBinOp_t(al, loc, target,
+            ASR::binopType::Add, call, type, nullptr));
+        pass_result.push_back(al, ASRUtils::STMT(ASR::make_Assignment_t(al, loc,
+            target, value, nullptr)));
+        return true;
+    }
+
+    /*
+        b[j, i] = a[i, j]                  ->  _lfortran_vdtranspose(...)
+        c[i, j] = c[i, j] + a[i, k]*b[k, j] ->  _lfortran_vdgemm(...)
+
+        for perfectly nested loops over `i`, `j` (and `k`) in any order, whose
+        bounds do not depend on each other.
+    */
+    bool replace_matrix_loop_nest(const ASR::DoLoop_t& x) {
+        std::vector<const ASR::DoLoop_t*> loops = {&x};
+        while( loops.back()->n_body == 1 &&
+               is_a<ASR::DoLoop_t>(*loops.back()->m_body[0]) && loops.size() < 3 ) {
+            loops.push_back(down_cast<ASR::DoLoop_t>(loops.back()->m_body[0]));
+        }
+        const ASR::DoLoop_t* innermost = loops.back();
+        if( loops.size() < 2 || innermost->n_body != 1 ||
+            !is_a<ASR::Assignment_t>(*innermost->m_body[0]) ) {
+            return false;
+        }
+        std::vector<ASR::symbol_t*> loop_vars;
+        for( const ASR::DoLoop_t* loop: loops ) {
+            if( !is_unit_stride_loop(*loop) ) {
+                return false;
+            }
+            loop_vars.push_back(get_loop_var(*loop));
+        }
+        for( const ASR::DoLoop_t* loop: loops ) {
+            if( uses_symbols(loop->m_head.m_start, loop_vars) ||
+                uses_symbols(loop->m_head.m_end, loop_vars) ) {
+                return false;
+            }
+        }
+        auto get_loop = [&](ASR::symbol_t* v) -> const ASR::DoLoop_t* {
+            for( const ASR::DoLoop_t* loop: loops ) {
+                if( get_loop_var(*loop) == v ) {
+                    return loop;
+                }
+            }
+            return nullptr;
+        };
+
+        ASR::Assignment_t* assignment = down_cast<ASR::Assignment_t>(innermost->m_body[0]);
+        if( !is_a<ASR::ArrayItem_t>(*assignment->m_target) ) {
+            return false;
+        }
+        ASR::ArrayItem_t* target = down_cast<ASR::ArrayItem_t>(assignment->m_target);
+        if( target->n_args != 2 || !target->m_args[0].m_right ||
+            !is_a<ASR::Var_t>(*target->m_args[0].m_right) ||
+            !target->m_args[1].m_right ||
+            !is_a<ASR::Var_t>(*target->m_args[1].m_right) ) {
+            return false;
+        }
+        ASR::symbol_t* i = down_cast<ASR::Var_t>(target->m_args[0].m_right)->m_v;
+        ASR::symbol_t* j = down_cast<ASR::Var_t>(target->m_args[1].m_right)->m_v;
+        const ASR::DoLoop_t *loop_i = get_loop(i), *loop_j = get_loop(j);
+        ASR::expr_t* c = get_indexed_array(assignment->m_target, {i, j});
+        if( !c || i == j || !loop_i || !loop_j ) {
+            return false;
+        }
+        for( const ASR::DoLoop_t* loop: loops ) {
+            std::vector<ASR::symbol_t*> target_array = {down_cast<ASR::Var_t>(c)->m_v};
+            if( uses_symbols(loop->m_head.m_start, target_array) ||
+                uses_symbols(loop->m_head.m_end, target_array) ) {
+                return false;
+            }
+        }
+        int kind = get_kind(c);
+        const Location& loc = x.base.base.loc;
+
+        if( loops.size() == 2 ) {
+            // c[i, j] = a[j, i]
+            ASR::expr_t* a = get_indexed_array(assignment->m_value, {j, i});
+            if( !a || same_array(a, c) || get_kind(a) != kind ) {
+                return false;
+            }
+            std::vector<ASR::ttype_t*> arg_types = {int64_type(loc),
+                int64_type(loc), cptr_type(loc), int64_type(loc),
+                cptr_type(loc), int64_type(loc)};
+            ASR::symbol_t* kernel = get_kernel(get_kernel_name("transpose", kind),
+                arg_types, nullptr);
+            if( !kernel ) {
+                return false;
+            }
+            Vec<ASR::call_arg_t> args = make_call_args({get_trip_count(*loop_j),
+                get_trip_count(*loop_i),
+                get_element_address(a, {loop_j->m_head.m_start, loop_i->m_head.m_start}),
+                get_leading_dimension(a),
+                get_element_address(c, {loop_i->m_head.m_start, loop_j->m_head.m_start}),
+                get_leading_dimension(c)});
+            pass_result.push_back(al, ASRUtils::STMT(ASR::make_SubroutineCall_t(al,
+                loc, kernel, nullptr, args.p, args.size(), nullptr)));
+            return true;
+        }
+
+        // c[i, j] = c[i, j] + a[i, k]*b[k, j]
+        ASR::symbol_t* k = nullptr;
+        for( ASR::symbol_t* v: loop_vars ) {
+            if( v != i && v != j ) {
+                k = v;
+            }
+        }
+        const ASR::DoLoop_t* loop_k = get_loop(k);
+        if( !k || !is_a<ASR::RealBinOp_t>(*assignment->m_value) ) {
+            return false;
+        }
+        ASR::RealBinOp_t* sum = down_cast<ASR::RealBinOp_t>(assignment->m_value);
+        if( sum->m_op != ASR::binopType::Add ) {
+            return false;
+        }
+        ASR::expr_t* term = nullptr;
+        ASR::expr_t* c_left = get_indexed_array(sum->m_left, {i, j});
+        ASR::expr_t* c_right = get_indexed_array(sum->m_right, {i, j});
+        if( c_left && same_array(c_left, c) ) {
+            term = sum->m_right;
+        } else if( c_right && same_array(c_right, c) ) {
+            term = sum->m_left;
+        } else {
+            return false;
+        }
+        if( !is_a<ASR::RealBinOp_t>(*term) ||
+            down_cast<ASR::RealBinOp_t>(term)->m_op != ASR::binopType::Mul ) {
+            return false;
+        }
+        ASR::RealBinOp_t* product = down_cast<ASR::RealBinOp_t>(term);
+        ASR::expr_t* a = get_indexed_array(product->m_left, {i, k});
+        ASR::expr_t* b = get_indexed_array(product->m_right, {k, j});
+        if( !a || !b ) {
+            a = get_indexed_array(product->m_right, {i, k});
+            b = get_indexed_array(product->m_left, {k, j});
+        }
+        if( !a || !b || same_array(a, c) || same_array(b, c) ||
+            get_kind(a) != kind || get_kind(b) != kind ) {
+            return false;
+        }
+        std::vector<ASR::ttype_t*> arg_types = {int64_type(loc), int64_type(loc),
+            int64_type(loc), cptr_type(loc), int64_type(loc), cptr_type(loc),
+            int64_type(loc), cptr_type(loc), int64_type(loc)};
+        ASR::symbol_t* kernel = get_kernel(get_kernel_name("gemm", kind),
+            arg_types, nullptr);
+        if( !kernel ) {
+            return false;
+        }
+        ASR::expr_t *i0 = loop_i->m_head.m_start, *j0 = loop_j->m_head.m_start,
+            *k0 = loop_k->m_head.m_start;
+        Vec<ASR::call_arg_t> args = make_call_args({get_trip_count(*loop_i),
+            get_trip_count(*loop_j), get_trip_count(*loop_k),
+            get_element_address(a, {i0, k0}), get_leading_dimension(a),
+            get_element_address(b, {k0, j0}), get_leading_dimension(b),
+            get_element_address(c, {i0, j0}), get_leading_dimension(c)});
+        pass_result.push_back(al, ASRUtils::STMT(ASR::make_SubroutineCall_t(al,
+            loc, kernel, nullptr, args.p, args.size(), nullptr)));
+        return true;
+    }
+
+    void visit_DoLoop(const ASR::DoLoop_t& x) {
+        if( is_unit_stride_loop(x) &&
+            (replace_reduction(x) || replace_matrix_loop_nest(x)) ) {
+            return ;
+        }
+        PassUtils::PassVisitor<ArrayKernelsVisitor>::visit_DoLoop(x);
+    }
+
+};
+
+void pass_replace_array_kernels(Allocator &al, ASR::TranslationUnit_t &unit,
+                                const LCompilers::PassOptions& /*pass_options*/) {
+    ArrayKernelsVisitor v(al, unit);
+    v.visit_TranslationUnit(unit);
+    PassUtils::UpdateDependenciesVisitor u(al);
+    u.visit_TranslationUnit(unit);
+}
+
+
+} // namespace LFortran
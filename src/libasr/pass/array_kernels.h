@@ -0,0 +1,14 @@
+#ifndef LIBASR_PASS_ARRAY_KERNELS_H
+#define LIBASR_PASS_ARRAY_KERNELS_H
+
+#include <libasr/asr.h>
+#include <libasr/utils.h>
+
+namespace LFortran {
+
+    void pass_replace_array_kernels(Allocator &al, ASR::TranslationUnit_t &unit,
+                                    const LCompilers::PassOptions& pass_options);
+
+} // namespace LFortran
+
+#endif // LIBASR_PASS_ARRAY_KERNELS_H
@@ -5,6 +5,7 @@
 #include <libasr/asr_verify.h>
 #include <libasr/pass/array_op.h>
 #include <libasr/pass/pass_utils.h>
+#include <libasr/string_utils.h>
 
 #include <vector>
 #include <utility>
@@ -544,6 +545,82 @@ public:
         return ASR::down_cast<ASR::Function_t>(x)->m_elemental;
     }
 
+    /*
+        Returns the vectorized kernel for the elemental function `x`, if there
+        is one. An elemental function which only wraps a C function of the
+        runtime library,
+
+            def sin(x: f64) -> f64:
+                return _lfortran_dsin(x)
+
+        can be applied to a whole array by the kernel `_lfortran_vdsin(n, x, y)`
+        if it is declared in the same module. These kernels are vectorized,
+        unlike a loop calling `_lfortran_dsin` for each element.
+    */
+    ASR::symbol_t* get_vector_kernel(ASR::symbol_t* x) {
+        ASR::Function_t* fn = ASR::down_cast<ASR::Function_t>(
+            ASRUtils::symbol_get_past_external(x));
+        if( fn->n_args != 1 || fn->m_return_var == nullptr ||
+            fn->n_body == 0 || !is_a<ASR::Assignment_t>(*fn->m_body[0]) ||
+            (fn->n_body == 2 && !is_a<ASR::Return_t>(*fn->m_body[1])) ||
+            fn->n_body > 2 ) {
+            return nullptr;
+        }
+        ASR::Assignment_t* assign = ASR::down_cast<ASR::Assignment_t>(fn->m_body[0]);
+        if( !is_a<ASR::Var_t>(*assign->m_target) ||
+            ASR::down_cast<ASR::Var_t>(assign->m_target)->m_v !=
+            ASR::down_cast<ASR::Var_t>(fn->m_return_var)->m_v ||
+            !is_a<ASR::FunctionCall_t>(*assign->m_value) ) {
+            return nullptr;
+        }
+        ASR::FunctionCall_t* call = ASR::down_cast<ASR::FunctionCall_t>(assign->m_value);
+        ASR::symbol_t* callee = ASRUtils::symbol_get_past_external(call->m_name);
+        if( call->n_args != 1 || !is_a<ASR::Var_t>(*call->m_args[0].m_value) ||
+            ASR::down_cast<ASR::Var_t>(call->m_args[0].m_value)->m_v !=
+            ASR::down_cast<ASR::Var_t>(fn->m_args[0])->m_v ||
+            !is_a<ASR::Function_t>(*callee) ||
+            ASR::down_cast<ASR::Function_t>(callee)->m_abi != ASR::abiType::BindC ) {
+            return nullptr;
+        }
+        std::string callee_name = ASRUtils::symbol_name(callee);
+        std::string prefix = "_lfortran_";
+        if( !startswith(callee_name, prefix) ) {
+            return nullptr;
+        }
+        std::string kernel_name = prefix + "v" + callee_name.substr(prefix.size());
+        ASR::symbol_t* kernel = fn->m_symtab->parent->get_symbol(kernel_name);
+        if( kernel == nullptr || !is_a<ASR::Function_t>(*kernel) ) {
+            return nullptr;
+        }
+        ASR::symbol_t* module = ASRUtils::get_asr_owner(kernel);
+        if( module == nullptr || !is_a<ASR::Module_t>(*module) ) {
+            return nullptr;
+        }
+        if( current_scope->resolve_symbol(kernel_name) == kernel ) {
+            return kernel;
+        }
+        ASR::symbol_t* kernel_ext = current_scope->get_symbol(kernel_name);
+        if( kernel_ext && ASRUtils::symbol_get_past_external(kernel_ext) == kernel ) {
+            return kernel_ext;
+        } else if( kernel_ext ) {
+            return nullptr;
+        }
+        kernel_ext = ASR::down_cast<ASR::symbol_t>(ASR::make_ExternalSymbol_t(al,
+            kernel->base.loc, current_scope, s2c(al, kernel_name), kernel,
+            ASR::down_cast<ASR::Module_t>(module)->m_name, nullptr, 0, s2c(al, kernel_name),
+            ASR::accessType::Private));
+        current_scope->add_symbol(kernel_name, kernel_ext);
+        return kernel_ext;
+    }
+
+    // Whole (contiguous) arrays, which can be passed to C by their data
+    bool is_whole_array(ASR::expr_t* x) {
+        return is_a<ASR::Var_t>(*x) &&
+            is_a<ASR::Variable_t>(*ASR::down_cast<ASR::Var_t>(x)->m_v) &&
+            !is_a<ASR::Pointer_t>(*ASRUtils::expr_type(x)) &&
+            ASRUtils::expr_abi(x) == ASR::abiType::Source;
+    }
+
     template <typename T>
     void visit_ArrayOpCommon(const T& x, std::string res_prefix) {
         bool current_status = use_custom_loop_params;
@@ -924,6 +1001,36 @@ public:
             }
             tmp_val = result_var;
 
+            ASR::symbol_t* kernel = nullptr;
+            if( x.n_args == 1 && is_whole_array(operands[0]) &&
+                is_whole_array(result_var) &&
+                (kernel = get_vector_kernel(x.m_name)) != nullptr ) {
+                // kernel(size(operand), c_loc(operand), c_loc(result_var))
+                const Location& loc = x.base.base.loc;
+                ASR::ttype_t* int64_type = ASRUtils::TYPE(ASR::make_Integer_t(al, loc, 8, nullptr, 0));
+                ASR::ttype_t* cptr_type = ASRUtils::TYPE(ASR::make_CPtr_t(al, loc));
+                Vec<ASR::call_arg_t> kernel_args;
+                kernel_args.reserve(al, 3);
+                ASR::expr_t* kernel_arg_values[3] = {
+                    ASRUtils::EXPR(ASR::make_ArraySize_t(al, loc, operands[0],
+                        nullptr, int64_type, nullptr)),
+                    ASRUtils::EXPR(ASR::make_PointerToCPtr_t(al, loc, operands[0],
+                        cptr_type, nullptr)),
+                    ASRUtils::EXPR(ASR::make_PointerToCPtr_t(al, loc, result_var,
+                        cptr_type, nullptr))
+                };
+                for( size_t iarg = 0; iarg < 3; iarg++ ) {
+                    ASR::call_arg_t kernel_arg;
+                    kernel_arg.loc = loc;
+                    kernel_arg.m_value = kernel_arg_values[iarg];
+                    kernel_args.push_back(al, kernel_arg);
+                }
+                pass_result.push_back(al, ASRUtils::STMT(ASR::make_SubroutineCall_t(al,
+                    loc, kernel, nullptr, kernel_args.p, kernel_args.size(), nullptr)));
+                result_var = nullptr;
+                return ;
+            }
+
             int n_dims = common_rank;
             Vec<ASR::expr_t*> idx_vars;
             PassUtils::create_idx_vars(idx_vars, n_dims, x.base.base.loc, al, current_scope);
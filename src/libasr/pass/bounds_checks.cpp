@@ -0,0 +1,443 @@
+#include <libasr/asr.h>
+#include <libasr/containers.h>
+#include <libasr/exception.h>
+#include <libasr/asr_utils.h>
+#include <libasr/asr_verify.h>
+#include <libasr/pass/pass_utils.h>
+#include <libasr/pass/bounds_checks.h>
+
+#include <set>
+#include <tuple>
+#include <vector>
+
+
+namespace LFortran {
+
+using ASR::down_cast;
+using ASR::is_a;
+
+/*
+
+This pass finds the list items in `DoLoop`s that cannot be out of bounds, so
+that the index bounds checks (`--enable-bounds-checking`) are not emitted for
+them. The index of such an item is the loop variable plus a constant and the
+list is not resized in the loop.
+
+If the bounds of the loop prove it, the check is removed:
+
+    for i in range(len(x)):
+        s += x[i]               # 0 <= i <= len(x) - 1, not checked
+
+Otherwise (and if the loop has no nested loops) the loop is versioned: the
+whole range of the index is checked once before the loop, the loop without
+the checks runs if it is in bounds and the original loop otherwise (which
+reports the exact index that is out of bounds):
+
+    if 1 - 1 >= 0 and n - 1 < len(x):
+        for i in range(1, n):
+            s += x[i - 1]       # not checked
+    else:
+        for i in range(1, n):
+            s += x[i - 1]       # checked
+
+The items are identified by their node, the pass must run before `do_loops`
+(which lowers the `DoLoop`s) and the later passes must not share the nodes
+with other statements (they duplicate the nodes they copy).
+
+*/
+
+static bool is_constant(ASR::expr_t* x, int64_t &n) {
+    ASR::expr_t* value = ASRUtils::expr_value(x);
+    if( value && is_a<ASR::IntegerConstant_t>(*value) ) {
+        n = down_cast<ASR::IntegerConstant_t>(value)->m_n;
+        return true;
+    }
+    return false;
+}
+
+// Splits `x` into `base + offset` with a constant `offset`, `base` is
+// nullptr if `x` is a constant
+static ASR::expr_t* split_offset(ASR::expr_t* x, int64_t &offset) {
+    offset = 0;
+    int64_t n;
+    while( true ) {
+        if( is_constant(x, n) ) {
+            offset += n;
+            return nullptr;
+        }
+        if( !is_a<ASR::IntegerBinOp_t>(*x) ) {
+            return x;
+        }
+        ASR::IntegerBinOp_t* binop = down_cast<ASR::IntegerBinOp_t>(x);
+        if( binop->m_op != ASR::binopType::Add && binop->m_op != ASR::binopType::Sub ) {
+            return x;
+        }
+        if( is_constant(binop->m_right, n) ) {
+            offset += binop->m_op == ASR::binopType::Add ? n : -n;
+            x = binop->m_left;
+        } else if( binop->m_op == ASR::binopType::Add &&
+                   is_constant(binop->m_left, n) ) {
+            offset += n;
+            x = binop->m_right;
+        } else {
+            return x;
+        }
+    }
+}
+
+static ASR::symbol_t* var_symbol(ASR::expr_t* x) {
+    if( x && is_a<ASR::Var_t>(*x) ) {
+        return down_cast<ASR::Var_t>(x)->m_v;
+    }
+    return nullptr;
+}
+
+// Collects what the body of a loop modifies and the list items in it
+class LoopBodyVisitor : public ASR::BaseWalkVisitor<LoopBodyVisitor>
+{
+public:
+    std::set<ASR::symbol_t*> assigned;
+    std::vector<ASR::ListItem_t*> items;
+    bool has_call, has_loop, has_goto;
+
+    LoopBodyVisitor(): has_call(false), has_loop(false), has_goto(false) {}
+
+    // `x.append(...)` etc. modify the list `x`, `x[i].append(...)` is
+    // conservatively treated the same way
+    void mark_container(ASR::expr_t* x) {
+        while( true ) {
+            if( is_a<ASR::ListItem_t>(*x) ) {
+                x = down_cast<ASR::ListItem_t>(x)->m_a;
+            } else if( is_a<ASR::DictItem_t>(*x) ) {
+                x = down_cast<ASR::DictItem_t>(x)->m_a;
+            } else {
+                break;
+            }
+        }
+        if( ASR::symbol_t* s = var_symbol(x) ) {
+            assigned.insert(s);
+        }
+    }
+
+    void visit_Assignment(const ASR::Assignment_t &x) {
+        if( ASR::symbol_t* s = var_symbol(x.m_target) ) {
+            assigned.insert(s);
+        }
+        ASR::BaseWalkVisitor<LoopBodyVisitor>::visit_Assignment(x);
+    }
+
+    void visit_ListItem(const ASR::ListItem_t &x) {
+        items.push_back(const_cast<ASR::ListItem_t*>(&x));
+        ASR::BaseWalkVisitor<LoopBodyVisitor>::visit_ListItem(x);
+    }
+
+    void visit_ListAppend(const ASR::ListAppend_t &x) {
+        mark_container(x.m_a);
+        ASR::BaseWalkVisitor<LoopBodyVisitor>::visit_ListAppend(x);
+    }
+
+    void visit_ListInsert(const ASR::ListInsert_t &x) {
+        mark_container(x.m_a);
+        ASR::BaseWalkVisitor<LoopBodyVisitor>::visit_ListInsert(x);
+    }
+
+    void visit_ListRemove(const ASR::ListRemove_t &x) {
+        mark_container(x.m_a);
+        ASR::BaseWalkVisitor<LoopBodyVisitor>::visit_ListRemove(x);
+    }
+
+    void visit_ListClear(const ASR::ListClear_t &x) {
+        mark_container(x.m_a);
+        ASR::BaseWalkVisitor<LoopBodyVisitor>::visit_ListClear(x);
+    }
+
+    void visit_ListPop(const ASR::ListPop_t &x) {
+        mark_container(x.m_a);
+        ASR::BaseWalkVisitor<LoopBodyVisitor>::visit_ListPop(x);
+    }
+
+    // The arguments can be modified by the callee
+    void mark_call_args(ASR::call_arg_t* args, size_t n_args) {
+        has_call = true;
+        for( size_t i = 0; i < n_args; i++ ) {
+            if( args[i].m_value ) {
+                mark_container(args[i].m_value);
+            }
+        }
+    }
+
+    void visit_FunctionCall(const ASR::FunctionCall_t &x) {
+        mark_call_args(x.m_args, x.n_args);
+        ASR::BaseWalkVisitor<LoopBodyVisitor>::visit_FunctionCall(x);
+    }
+
+    void visit_SubroutineCall(const ASR::SubroutineCall_t &x) {
+        mark_call_args(x.m_args, x.n_args);
+        ASR::BaseWalkVisitor<LoopBodyVisitor>::visit_SubroutineCall(x);
+    }
+
+    void visit_DoLoop(const ASR::DoLoop_t &x) {
+        has_loop = true;
+        if( ASR::symbol_t* s = var_symbol(x.m_head.m_v) ) {
+            assigned.insert(s);
+        }
+        ASR::BaseWalkVisitor<LoopBodyVisitor>::visit_DoLoop(x);
+    }
+
+    void visit_WhileLoop(const ASR::WhileLoop_t &x) {
+        has_loop = true;
+        ASR::BaseWalkVisitor<LoopBodyVisitor>::visit_WhileLoop(x);
+    }
+
+    void visit_GoTo(const ASR::GoTo_t &/*x*/) {
+        has_goto = true;
+    }
+
+    void visit_GoToTarget(const ASR::GoToTarget_t &/*x*/) {
+        has_goto = true;
+    }
+};
+
+class BoundsCheckVisitor : public PassUtils::PassVisitor<BoundsCheckVisitor>
+{
+private:
+    std::set<const ASR::expr_t*> &unchecked;
+    ASRUtils::ExprStmtDuplicator node_duplicator;
+
+    // The checks that version a loop: (list, offset of the index, upper
+    // bound) for `lo + offset >= 0` and `hi + offset < len(list)`
+    typedef std::tuple<ASR::symbol_t*, int64_t, bool> Condition;
+
+    // Nested functions can modify the local variables of their parent
+    bool has_nested_functions() {
+        for( auto &item: current_scope->get_scope() ) {
+            if( is_a<ASR::Function_t>(*item.second) ) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The variable `s` keeps its value in the loop
+    bool is_invariant(ASR::symbol_t* s, const LoopBodyVisitor &body) {
+        if( body.assigned.find(s) != body.assigned.end() ) {
+            return false;
+        }
+        if( !body.has_call ) {
+            return true;
+        }
+        // A call can modify the global variables and (through the
+        // arguments) the objects they are bound to
+        if( !is_a<ASR::Variable_t>(*s) ) {
+            return false;
+        }
+        ASR::Variable_t* v = down_cast<ASR::Variable_t>(s);
+        return v->m_parent_symtab == current_scope &&
+               (v->m_intent == ASRUtils::intent_local ||
+                v->m_intent == ASRUtils::intent_return_var) &&
+               !has_nested_functions();
+    }
+
+    // `x` has the same value in all iterations of the loop
+    bool is_invariant(ASR::expr_t* x, const LoopBodyVisitor &body) {
+        int64_t n;
+        if( is_constant(x, n) ) {
+            return true;
+        }
+        switch( x->type ) {
+            case ASR::exprType::Var: {
+                return is_invariant(down_cast<ASR::Var_t>(x)->m_v, body);
+            }
+            case ASR::exprType::ListLen: {
+                ASR::symbol_t* s = var_symbol(down_cast<ASR::ListLen_t>(x)->m_arg);
+                return s && is_invariant(s, body);
+            }
+            case ASR::exprType::IntegerBinOp: {
+                ASR::IntegerBinOp_t* binop = down_cast<ASR::IntegerBinOp_t>(x);
+                return is_invariant(binop->m_left, body) &&
+                       is_invariant(binop->m_right, body);
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+
+    ASR::expr_t* make_int(const Location &loc, int64_t n) {
+        ASR::ttype_t* int_type = ASRUtils::TYPE(ASR::make_Integer_t(al, loc, 4, nullptr, 0));
+        return ASRUtils::EXPR(ASR::make_IntegerConstant_t(al, loc, n, int_type));
+    }
+
+    ASR::expr_t* make_condition(const Location &loc, const Condition &c,
+                                ASR::expr_t* lo, ASR::expr_t* hi) {
+        ASR::ttype_t* int_type = ASRUtils::TYPE(ASR::make_Integer_t(al, loc, 4, nullptr, 0));
+        ASR::ttype_t* logical_type = ASRUtils::TYPE(ASR::make_Logical_t(al, loc, 4, nullptr, 0));
+        int64_t offset = std::get<1>(c);
+        if( !std::get<2>(c) ) {
+            // lo >= -offset
+            return ASRUtils::EXPR(ASR::make_IntegerCompare_t(al, loc,
+                node_duplicator.duplicate_expr(lo), ASR::cmpopType::GtE,
+                make_int(loc, -offset), logical_type, nullptr));
+        }
+        // hi + offset < len(list)
+        ASR::expr_t* left = node_duplicator.duplicate_expr(hi);
+        if( offset != 0 ) {
+            left = ASRUtils::EXPR(ASR::make_IntegerBinOp_t(al, loc, left,
+                ASR::binopType::Add, make_int(loc, offset), int_type, nullptr));
+        }
+        ASR::symbol_t* list = std::get<0>(c);
+        ASR::expr_t* len = ASRUtils::EXPR(ASR::make_ListLen_t(al, loc,
+            ASRUtils::EXPR(ASR::make_Var_t(al, loc, list)), int_type, nullptr));
+        return ASRUtils::EXPR(ASR::make_IntegerCompare_t(al, loc, left,
+            ASR::cmpopType::Lt, len, logical_type, nullptr));
+    }
+
+    // Returns the checks that are needed for the items of the loop `x` that
+    // are not proven in bounds (those are added to `unchecked`), `guarded`
+    // gets the items that are in bounds if the checks pass
+    std::vector<Condition> analyse(const ASR::DoLoop_t &x,
+            std::vector<ASR::ListItem_t*> &guarded) {
+        std::vector<Condition> conditions;
+        ASR::symbol_t* loop_var = var_symbol(x.m_head.m_v);
+        if( !loop_var || !x.m_head.m_start || !x.m_head.m_end ||
+            !ASRUtils::is_integer(*ASRUtils::expr_type(x.m_head.m_v)) ||
+            ASRUtils::extract_kind_from_ttype_t(ASRUtils::expr_type(x.m_head.m_v)) != 4 ) {
+            return conditions;
+        }
+        int64_t step = 1;
+        if( x.m_head.m_increment && (!is_constant(x.m_head.m_increment, step) ||
+                                     step == 0) ) {
+            return conditions;
+        }
+        // The loop variable takes the values lo <= i <= hi
+        ASR::expr_t* lo = step > 0 ? x.m_head.m_start : x.m_head.m_end;
+        ASR::expr_t* hi = step > 0 ? x.m_head.m_end : x.m_head.m_start;
+        int64_t lo_offset, hi_offset;
+        ASR::expr_t* lo_base = split_offset(lo, lo_offset);
+        ASR::expr_t* hi_base = split_offset(hi, hi_offset);
+
+        LoopBodyVisitor body;
+        for( size_t i = 0; i < x.n_body; i++ ) {
+            body.visit_stmt(*x.m_body[i]);
+        }
+        if( !is_invariant(loop_var, body) ) {
+            return conditions;
+        }
+        bool lo_invariant = is_invariant(lo, body);
+        bool hi_invariant = is_invariant(hi, body);
+        for( auto &item: body.items ) {
+            ASR::symbol_t* list = var_symbol(item->m_a);
+            if( !list || !is_a<ASR::List_t>(*ASRUtils::expr_type(item->m_a)) ||
+                !is_invariant(list, body) ) {
+                continue;
+            }
+            int64_t offset;
+            if( var_symbol(split_offset(item->m_pos, offset)) != loop_var ) {
+                continue;
+            }
+            // 0 <= lo + offset
+            bool lo_proven = lo_base == nullptr && lo_offset + offset >= 0;
+            // hi + offset < len(list), with hi = len(list) + hi_offset
+            bool hi_proven = hi_base && is_a<ASR::ListLen_t>(*hi_base) &&
+                var_symbol(down_cast<ASR::ListLen_t>(hi_base)->m_arg) == list &&
+                hi_offset + offset < 0;
+            if( lo_proven && hi_proven ) {
+                unchecked.insert(&item->base);
+                continue;
+            }
+            if( (!lo_proven && !lo_invariant) || (!hi_proven && !hi_invariant) ) {
+                continue;
+            }
+            if( !lo_proven ) {
+                conditions.push_back(Condition(list, offset, false));
+            }
+            if( !hi_proven ) {
+                conditions.push_back(Condition(list, offset, true));
+            }
+            guarded.push_back(item);
+        }
+        if( body.has_loop || body.has_goto ) {
+            // Versioning would duplicate the nested loops
+            conditions.clear();
+            guarded.clear();
+        }
+        return conditions;
+    }
+
+public:
+    BoundsCheckVisitor(Allocator &al_, std::set<const ASR::expr_t*> &unchecked_) :
+        PassVisitor(al_, nullptr), unchecked(unchecked_), node_duplicator(al_) {
+        pass_result.reserve(al, 1);
+    }
+
+    void visit_If(const ASR::If_t &x) {
+        ASR::If_t &xx = const_cast<ASR::If_t&>(x);
+        transform_stmts(xx.m_body, xx.n_body);
+        transform_stmts(xx.m_orelse, xx.n_orelse);
+    }
+
+    void visit_WhileLoop(const ASR::WhileLoop_t &x) {
+        ASR::WhileLoop_t &xx = const_cast<ASR::WhileLoop_t&>(x);
+        transform_stmts(xx.m_body, xx.n_body);
+    }
+
+    void visit_DoLoop(const ASR::DoLoop_t &x) {
+        // The nested loops first
+        ASR::DoLoop_t &xx = const_cast<ASR::DoLoop_t&>(x);
+        transform_stmts(xx.m_body, xx.n_body);
+
+        std::vector<ASR::ListItem_t*> guarded;
+        std::vector<Condition> conditions = analyse(x, guarded);
+        if( conditions.empty() ) {
+            return ;
+        }
+        // The checked loop, the items proven in bounds in it are found again
+        ASR::stmt_t* checked_loop = node_duplicator.duplicate_stmt(
+            const_cast<ASR::stmt_t*>(&x.base));
+        std::vector<ASR::ListItem_t*> checked_guarded;
+        analyse(*down_cast<ASR::DoLoop_t>(checked_loop), checked_guarded);
+
+        for( auto &item: guarded ) {
+            unchecked.insert(&item->base);
+        }
+        const Location &loc = x.base.base.loc;
+        int64_t step = 1;
+        if( x.m_head.m_increment ) {
+            is_constant(x.m_head.m_increment, step);
+        }
+        ASR::expr_t* lo = step > 0 ? x.m_head.m_start : x.m_head.m_end;
+        ASR::expr_t* hi = step > 0 ? x.m_head.m_end : x.m_head.m_start;
+        ASR::ttype_t* logical_type = ASRUtils::TYPE(ASR::make_Logical_t(al, loc, 4, nullptr, 0));
+        std::set<Condition> done;
+        ASR::expr_t* test = nullptr;
+        for( auto &c: conditions ) {
+            if( !done.insert(c).second ) {
+                continue;
+            }
+            ASR::expr_t* cond = make_condition(loc, c, lo, hi);
+            if( test ) {
+                test = ASRUtils::EXPR(ASR::make_LogicalBinOp_t(al, loc, test,
+                    ASR::logicalbinopType::And, cond, logical_type, nullptr));
+            } else {
+                test = cond;
+            }
+        }
+        Vec<ASR::stmt_t*> body;
+        body.reserve(al, 1);
+        body.push_back(al, const_cast<ASR::stmt_t*>(&x.base));
+        Vec<ASR::stmt_t*> orelse;
+        orelse.reserve(al, 1);
+        orelse.push_back(al, checked_loop);
+        pass_result.push_back(al, ASRUtils::STMT(ASR::make_If_t(al, loc, test,
+            body.p, body.size(), orelse.p, orelse.size())));
+    }
+};
+
+void pass_eliminate_bounds_checks(Allocator &al, ASR::TranslationUnit_t &unit,
+                                  std::set<const ASR::expr_t*> &unchecked) {
+    BoundsCheckVisitor v(al, unchecked);
+    v.visit_TranslationUnit(unit);
+}
+
+
+} // namespace LFortran
@@ -0,0 +1,19 @@
+#ifndef LFORTRAN_PASS_BOUNDS_CHECKS_H
+#define LFORTRAN_PASS_BOUNDS_CHECKS_H
+
+#include <libasr/asr.h>
+
+#include <set>
+
+namespace LFortran {
+
+    // Fills `unchecked` with the `ListItem` expressions whose index is known
+    // to be within the bounds of the list, the backend does not emit their
+    // bounds check. Must run before `do_loops`, the analysis needs the
+    // `DoLoop`s.
+    void pass_eliminate_bounds_checks(Allocator &al, ASR::TranslationUnit_t &unit,
+                                      std::set<const ASR::expr_t*> &unchecked);
+
+} // namespace LFortran
+
+#endif // LFORTRAN_PASS_BOUNDS_CHECKS_H
@@ -105,5 +105,11 @@ void pass_dead_code_removal(Allocator &al, ASR::TranslationUnit_t &unit,
     v.visit_TranslationUnit(unit);
 }
 
+void pass_dead_code_removal_symbol(Allocator &al, ASR::TranslationUnit_t &/*unit*/,
+                                   ASR::symbol_t &sym, const LCompilers::PassOptions& pass_options) {
+    DeadCodeRemovalVisitor v(al, pass_options.runtime_library_dir);
+    v.visit_symbol(sym);
+}
+
 
 } // namespace LFortran
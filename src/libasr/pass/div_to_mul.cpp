@@ -84,5 +84,11 @@ void pass_replace_div_to_mul(Allocator &al, ASR::TranslationUnit_t &unit,
     v.visit_TranslationUnit(unit);
 }
 
+void pass_replace_div_to_mul_symbol(Allocator &al, ASR::TranslationUnit_t &/*unit*/,
+                                    ASR::symbol_t &sym, const LCompilers::PassOptions& pass_options) {
+    DivToMulVisitor v(al, pass_options.runtime_library_dir);
+    v.visit_symbol(sym);
+}
+
 
 } // namespace LFortran
@@ -56,5 +56,15 @@ void pass_replace_do_loops(Allocator &al, ASR::TranslationUnit_t &unit,
     }
 }
 
+void pass_replace_do_loops_symbol(Allocator &al, ASR::TranslationUnit_t &/*unit*/,
+                                  ASR::symbol_t &sym, const LCompilers::PassOptions& /*pass_options*/) {
+    DoLoopVisitor v(al);
+    v.asr_changed = true;
+    while( v.asr_changed ) {
+        v.asr_changed = false;
+        v.visit_symbol(sym);
+    }
+}
+
 
 } // namespace LFortran
@@ -214,5 +214,11 @@ void pass_replace_flip_sign(Allocator &al, ASR::TranslationUnit_t &unit,
     v.visit_TranslationUnit(unit);
 }
 
+void pass_replace_flip_sign_symbol(Allocator &al, ASR::TranslationUnit_t &unit,
+                                   ASR::symbol_t &sym, const LCompilers::PassOptions& pass_options) {
+    FlipSignVisitor v(al, unit, pass_options);
+    v.visit_symbol(sym);
+}
+
 
 } // namespace LFortran
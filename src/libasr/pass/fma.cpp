@@ -172,5 +172,11 @@ void pass_replace_fma(Allocator &al, ASR::TranslationUnit_t &unit,
     v.visit_TranslationUnit(unit);
 }
 
+void pass_replace_fma_symbol(Allocator &al, ASR::TranslationUnit_t &unit,
+                             ASR::symbol_t &sym, const LCompilers::PassOptions& pass_options) {
+    FMAVisitor v(al, unit, pass_options);
+    v.visit_symbol(sym);
+}
+
 
 } // namespace LFortran
@@ -49,4 +49,10 @@ void pass_replace_forall(Allocator &al, ASR::TranslationUnit_t &unit,
     v.visit_TranslationUnit(unit);
 }
 
+void pass_replace_forall_symbol(Allocator &al, ASR::TranslationUnit_t &/*unit*/,
+                                ASR::symbol_t &sym, const LCompilers::PassOptions& /*pass_options*/) {
+    ForAllVisitor v(al);
+    v.visit_symbol(sym);
+}
+
 } // namespace LFortran
@@ -3,11 +3,14 @@
 #include <libasr/exception.h>
 #include <libasr/asr_utils.h>
 #include <libasr/asr_verify.h>
+#include <libasr/diagnostics.h>
 #include <libasr/pass/inline_function_calls.h>
 #include <libasr/pass/pass_utils.h>
 
+#include <algorithm>
 #include <vector>
 #include <map>
+#include <set>
 #include <utility>
 
 
@@ -34,7 +37,53 @@ to:
 
     c = a + 5
 
+With `--fast` a call is inlined if it is cheap enough. The cost of a call
+is the size of the callee (its statements and expressions), less the uses
+of the arguments that are constants (they fold after inlining). It is
+compared with `inline_threshold`, which is scaled by the loop depth of the
+call (up to 4x), because a call in a loop runs more often. A function grows
+by at most `inline_budget`, a recursive function is inlined into it at most
+once and the calls that are cold in the `--profile-use` profile are not
+inlined. Functions marked `@inline` are always inlined. The decisions are
+reported as remarks if requested.
+
 */
+
+// Computes the size of a function body in the cost model, the uses of
+// every variable and the functions called in it
+class InlineCostVisitor : public ASR::BaseWalkVisitor<InlineCostVisitor>
+{
+public:
+
+    int64_t size = 0;
+    std::map<ASR::symbol_t*, int64_t> uses;
+    std::set<ASR::symbol_t*> callees;
+
+    void visit_stmt(const ASR::stmt_t &x) {
+        size++;
+        ASR::BaseWalkVisitor<InlineCostVisitor>::visit_stmt(x);
+    }
+
+    void visit_expr(const ASR::expr_t &x) {
+        size++;
+        ASR::BaseWalkVisitor<InlineCostVisitor>::visit_expr(x);
+    }
+
+    void visit_Var(const ASR::Var_t &x) {
+        uses[x.m_v]++;
+    }
+
+    void visit_FunctionCall(const ASR::FunctionCall_t &x) {
+        callees.insert(ASRUtils::symbol_get_past_external(x.m_name));
+        ASR::BaseWalkVisitor<InlineCostVisitor>::visit_FunctionCall(x);
+    }
+
+    void visit_SubroutineCall(const ASR::SubroutineCall_t &x) {
+        callees.insert(ASRUtils::symbol_get_past_external(x.m_name));
+        ASR::BaseWalkVisitor<InlineCostVisitor>::visit_SubroutineCall(x);
+    }
+};
+
 class InlineFunctionCallVisitor : public PassUtils::PassVisitor<InlineFunctionCallVisitor>
 {
 private:
@@ -55,6 +104,22 @@ private:
 
     bool inline_external_symbol_calls;
 
+    // Calls in these functions are not inlined (unless requested with
+    // `@inline`), they are cold in the `--profile-use` profile
+    const std::set<std::string> &cold_functions;
+    bool current_routine_cold;
+
+    // See `LCompilers::PassOptions::inline_threshold`
+    int64_t inline_threshold, inline_budget;
+    int64_t loop_depth;
+    // The size inlined into every function so far
+    std::map<std::string, int64_t> growth;
+    // A recursive function is inlined into another one at most once (one
+    // level of the recursion)
+    std::set<std::pair<std::string, ASR::symbol_t*>> recursive_inlined;
+
+    diag::Diagnostics *remarks;
+    std::set<std::pair<uint32_t, std::string>> reported_remarks;
 
     ASRUtils::ExprStmtDuplicator node_duplicator;
 
@@ -68,12 +133,18 @@ public:
     bool function_inlined;
 
     InlineFunctionCallVisitor(Allocator &al_, const std::string& rl_path_,
-                              bool inline_external_symbol_calls_, bool is_fast_)
+                              bool inline_external_symbol_calls_, bool is_fast_,
+                              const std::set<std::string> &cold_functions_,
+                              int64_t inline_threshold_, int64_t inline_budget_,
+                              diag::Diagnostics *remarks_)
     : PassVisitor(al_, nullptr),
     rl_path(rl_path_), function_result_var(nullptr),
     from_inline_function_call(false), inlining_function(false), fixed_duplicated_expr_stmt(false),
     is_fast(is_fast_),
     current_routine(""), inline_external_symbol_calls(inline_external_symbol_calls_),
+    cold_functions(cold_functions_), current_routine_cold(false),
+    inline_threshold(inline_threshold_), inline_budget(inline_budget_),
+    loop_depth(0), remarks(remarks_),
     node_duplicator(al_), current_routine_scope(nullptr),
     label_generator(ASRUtils::LabelGenerator::get_instance()),
     empty_block(nullptr), return_replacer(al_, 0),
@@ -91,8 +162,61 @@ public:
         // which requires to generate a TransformVisitor.
         ASR::Function_t &xx = const_cast<ASR::Function_t&>(x);
         current_routine = std::string(xx.m_name);
+        current_routine_cold = PassUtils::is_cold_function(x, cold_functions);
         PassUtils::PassVisitor<InlineFunctionCallVisitor>::visit_Function(x);
         current_routine.clear();
+        current_routine_cold = false;
+    }
+
+    // Reports the inlining decision `msg` for the call at `loc` (once, the
+    // pass visits the calls twice)
+    void remark(const Location &loc, const std::string &msg) {
+        if( remarks && reported_remarks.insert(std::make_pair(loc.first, msg)).second ) {
+            remarks->diagnostics.push_back(diag::Diagnostic(msg,
+                diag::Level::Note, diag::Stage::ASRPass,
+                {diag::Label("", {loc})}));
+        }
+    }
+
+    // Transforms a body of the current statement, the statements inlined
+    // for its test (or loop head) are kept in `pass_result` and are
+    // inserted before it
+    void transform_body(ASR::stmt_t **&m_body, size_t &n_body) {
+        Vec<ASR::stmt_t*> pass_result_before = pass_result;
+        pass_result.reserve(al, 1);
+        transform_stmts(m_body, n_body);
+        pass_result = pass_result_before;
+        if( pass_result.size() > 0 ) {
+            retain_original_stmt = true;
+        }
+    }
+
+    void visit_If(const ASR::If_t &x) {
+        ASR::If_t &xx = const_cast<ASR::If_t&>(x);
+        visit_expr(*x.m_test);
+        transform_body(xx.m_body, xx.n_body);
+        transform_body(xx.m_orelse, xx.n_orelse);
+    }
+
+    void visit_WhileLoop(const ASR::WhileLoop_t &x) {
+        ASR::WhileLoop_t &xx = const_cast<ASR::WhileLoop_t&>(x);
+        if( inlining_function ) {
+            // The test is evaluated in every iteration, the calls in it are
+            // not inlined, only the variables of a function body are
+            // replaced
+            visit_expr(*x.m_test);
+        }
+        loop_depth++;
+        transform_body(xx.m_body, xx.n_body);
+        loop_depth--;
+    }
+
+    void visit_DoLoop(const ASR::DoLoop_t &x) {
+        ASR::DoLoop_t &xx = const_cast<ASR::DoLoop_t&>(x);
+        visit_do_loop_head(x.m_head);
+        loop_depth++;
+        transform_body(xx.m_body, xx.n_body);
+        loop_depth--;
     }
 
     void visit_Var(const ASR::Var_t& x) {
@@ -208,8 +332,10 @@ public:
         }
 
         // Avoid inlining current function call if its a recursion.
+        // Interfaces (such as C functions) have no body to inline.
         ASR::Function_t* func = ASR::down_cast<ASR::Function_t>(routine);
         if( ASRUtils::is_intrinsic_function2(func) ||
+            func->m_deftype == ASR::deftypeType::Interface ||
             std::string(func->m_name) == current_routine ) {
             return ;
         }
@@ -218,6 +344,50 @@ public:
             return ;
         }
 
+        std::string callee_name = "'" + std::string(func->m_name) + "'";
+        std::string caller_name = current_routine.empty() ? "the program"
+            : "'" + current_routine + "'";
+        if( !func->m_inline && current_routine_cold ) {
+            remark(x.base.base.loc, callee_name + " not inlined into " +
+                caller_name + ": the call is cold in the profile");
+            return ;
+        }
+
+        InlineCostVisitor cost;
+        for( size_t i = 0; i < func->n_body; i++ ) {
+            cost.visit_stmt(*func->m_body[i]);
+        }
+        if( !func->m_inline ) {
+            if( cost.callees.find(routine) != cost.callees.end() &&
+                recursive_inlined.find(std::make_pair(current_routine, routine))
+                    != recursive_inlined.end() ) {
+                remark(x.base.base.loc, callee_name + " not inlined into " +
+                    caller_name + ": it is recursive and was inlined once");
+                return ;
+            }
+            int64_t folded = 0;
+            for( size_t i = 0; i < func->n_args && i < x.n_args; i++ ) {
+                if( x.m_args[i].m_value && ASR::is_a<ASR::Var_t>(*func->m_args[i]) &&
+                    ASRUtils::expr_value(x.m_args[i].m_value) ) {
+                    folded += cost.uses[ASR::down_cast<ASR::Var_t>(func->m_args[i])->m_v];
+                }
+            }
+            int64_t call_cost = cost.size - folded;
+            int64_t threshold = inline_threshold * (1 + std::min(loop_depth, (int64_t) 3));
+            if( call_cost > threshold ) {
+                remark(x.base.base.loc, callee_name + " not inlined into " +
+                    caller_name + ": cost " + std::to_string(call_cost) +
+                    " is above the threshold " + std::to_string(threshold));
+                return ;
+            }
+            if( growth[current_routine] + cost.size > inline_budget ) {
+                remark(x.base.base.loc, callee_name + " not inlined into " +
+                    caller_name + ": it would exceed the inlining budget " +
+                    std::to_string(inline_budget));
+                return ;
+            }
+        }
+
         current_routine_scope = func->m_symtab;
 
         ASR::expr_t* return_var = nullptr;
@@ -393,6 +563,14 @@ public:
             }
             function_result_var = nullptr;
         }
+        if( success ) {
+            growth[current_routine] += cost.size;
+            if( cost.callees.find(routine) != cost.callees.end() ) {
+                recursive_inlined.insert(std::make_pair(current_routine, routine));
+            }
+            remark(x.base.base.loc, callee_name + " inlined into " + caller_name +
+                (func->m_inline ? " (@inline)" : " (size " + std::to_string(cost.size) + ")"));
+        }
         // At least one function is inlined
         function_inlined = success;
         success = false;
@@ -456,7 +634,10 @@ void pass_inline_function_calls(Allocator &al, ASR::TranslationUnit_t &unit,
                                 const LCompilers::PassOptions& pass_options) {
     std::string rl_path = pass_options.runtime_library_dir;
     bool inline_external_symbol_calls = pass_options.inline_external_symbol_calls;
-    InlineFunctionCallVisitor v(al, rl_path, inline_external_symbol_calls, pass_options.fast);
+    InlineFunctionCallVisitor v(al, rl_path, inline_external_symbol_calls,
+        pass_options.fast, pass_options.cold_functions,
+        pass_options.inline_threshold, pass_options.inline_budget,
+        pass_options.remarks);
     v.configure_node_duplicator(false);
     v.visit_TranslationUnit(unit);
     v.configure_node_duplicator(true);
@@ -8,6 +8,7 @@
 
 #include <vector>
 #include <map>
+#include <set>
 #include <utility>
 #include <cmath>
 
@@ -27,17 +28,35 @@ private:
 
     ASRUtils::ExprStmtDuplicator node_duplicator;
 
+    // Loops in these functions are not unrolled, they are cold in the
+    // `--profile-use` profile
+    const std::set<std::string> &cold_functions;
+
+    bool in_cold_function;
+
 public:
 
     LoopUnrollVisitor(Allocator &al_, const std::string& rl_path_,
-                      size_t unroll_factor_) :
+                      size_t unroll_factor_,
+                      const std::set<std::string> &cold_functions_) :
     PassVisitor(al_, nullptr), rl_path(rl_path_),
-    unroll_factor(unroll_factor_), node_duplicator(al_)
+    unroll_factor(unroll_factor_), node_duplicator(al_),
+    cold_functions(cold_functions_), in_cold_function(false)
     {
         pass_result.reserve(al, 1);
     }
 
+    void visit_Function(const ASR::Function_t &x) {
+        bool in_cold_function_copy = in_cold_function;
+        in_cold_function = PassUtils::is_cold_function(x, cold_functions);
+        PassUtils::PassVisitor<LoopUnrollVisitor>::visit_Function(x);
+        in_cold_function = in_cold_function_copy;
+    }
+
     void visit_DoLoop(const ASR::DoLoop_t& x) {
+        if( in_cold_function ) {
+            return ;
+        }
         ASR::DoLoop_t& xx = const_cast<ASR::DoLoop_t&>(x);
         ASR::do_loop_head_t x_head = x.m_head;
         ASR::expr_t* x_start = ASRUtils::expr_value(x_head.m_start);
@@ -110,7 +129,7 @@ void pass_loop_unroll(Allocator &al, ASR::TranslationUnit_t &unit,
                       const LCompilers::PassOptions& pass_options) {
     std::string rl_path = pass_options.runtime_library_dir;
     int64_t unroll_factor = pass_options.unroll_factor;
-    LoopUnrollVisitor v(al, rl_path, unroll_factor);
+    LoopUnrollVisitor v(al, rl_path, unroll_factor, pass_options.cold_functions);
     v.visit_TranslationUnit(unit);
 }
 
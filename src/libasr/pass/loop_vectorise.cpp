@@ -6,9 +6,10 @@
 #include <libasr/pass/loop_vectorise.h>
 #include <libasr/pass/pass_utils.h>
 
+#include <algorithm>
 #include <vector>
-#include <utility>
-#include <cmath>
+#include <map>
+#include <set>
 
 
 namespace LFortran {
@@ -18,180 +19,556 @@ using ASR::is_a;
 
 /*
 
-This ASR pass converts loops over arrays with a call to internal
-optimization routine for loop vectorisation. This allows backend
-specific code generation for vector operations resulting in optimized
-code.
+This ASR pass converts the innermost loops that can be vectorised into
+concurrent loops. The body of such a loop only contains assignments (and
+if statements made of assignments) to the array elements indexed by the
+loop variable and to scalars, including reductions like sums, products,
+minimum and maximum. The right hand sides are made of arithmetic, casts,
+comparisons and conditional expressions over array elements and scalars.
+The arrays written in the loop are only accessed at the current iteration.
+
+The scalars which are not local variables of the current function are
+copied into local variables before the loop (and back after the loop if
+they are written), so that they can be kept in registers.
+
+The backend emits a concurrent loop such that it is vectorised with the
+vector width of the target (see `--target` and `--target-cpu`), together
+with the remainder loop for the iterations that do not fill a vector.
 
 Converts:
 
-    i: i32
-    for i in range(9216):
-        a[i] = b[i]
+    def axpy(n: i32, a: f64, x: f64[:], y: f64[:]):
+        i: i32
+        for i in range(n):
+            y[i] = a*x[i] + y[i]
 
 to:
 
-    for i in range(0, 9216, 8):
-        vector_copy(8, a[i*8:(i+1)*8], b[i*8:(i+1)*8])
+    def axpy(n: i32, a: f64, x: f64[:], y: f64[:]):
+        i: i32
+        ~a_vec: f64
+        ~a_vec = a
+        do concurrent i = 0, n - 1
+            y[i] = ~a_vec*x[i] + y[i]
 
 */
 class LoopVectoriseVisitor : public PassUtils::SkipOptimizationFunctionVisitor<LoopVectoriseVisitor>
 {
 private:
-    ASR::TranslationUnit_t &unit;
-
-    std::string rl_path;
-
-    // To make sure that FMA is applied only for
-    // the nodes implemented in this class
-    bool from_loop_vectorise;
 
-    const int64_t avx512 = 512;
+    // State of the loop being analysed
+    ASR::symbol_t* loop_var;
+    std::vector<ASR::symbol_t*> nonlocal_scalars;
+    std::set<ASR::symbol_t*> written_scalars;
+    std::set<ASR::symbol_t*> index_scalars;
+    std::set<ASR::symbol_t*> compared_scalars;
+    std::map<ASR::symbol_t*, std::vector<ASR::ArrayItem_t*>> array_items;
+    std::set<ASR::symbol_t*> written_arrays;
+    std::map<ASR::symbol_t*, ASR::symbol_t*> scalar_copies;
 
 public:
-    LoopVectoriseVisitor(Allocator &al_, ASR::TranslationUnit_t &unit_,
-                         const std::string& rl_path_) : SkipOptimizationFunctionVisitor(al_),
-    unit(unit_), rl_path(rl_path_), from_loop_vectorise(false)
+
+    LoopVectoriseVisitor(Allocator &al_) : SkipOptimizationFunctionVisitor(al_),
+    loop_var(nullptr)
     {
         pass_result.reserve(al, 1);
     }
 
-    bool is_loop(const ASR::stmt_t& x) {
-        return (ASR::is_a<ASR::DoLoop_t>(x) ||
-                ASR::is_a<ASR::WhileLoop_t>(x));
+    bool is_scalar_type(ASR::ttype_t* type) {
+        return !ASRUtils::is_array(type) &&
+               (is_a<ASR::Integer_t>(*type) ||
+                is_a<ASR::Real_t>(*type) ||
+                is_a<ASR::Logical_t>(*type));
+    }
+
+    bool is_local_variable(ASR::symbol_t* sym) {
+        if( !is_a<ASR::Variable_t>(*sym) ) {
+            return false;
+        }
+        ASR::Variable_t* v = down_cast<ASR::Variable_t>(sym);
+        return v->m_parent_symtab == current_scope &&
+               (v->m_intent == ASR::intentType::Local ||
+                v->m_intent == ASR::intentType::ReturnVar);
+    }
+
+    bool is_loop_var(ASR::expr_t* x) {
+        return is_a<ASR::Var_t>(*x) &&
+               down_cast<ASR::Var_t>(x)->m_v == loop_var;
+    }
+
+    void add_scalar(ASR::symbol_t* sym, bool written) {
+        if( written ) {
+            written_scalars.insert(sym);
+        }
+        if( !is_local_variable(sym) &&
+            std::find(nonlocal_scalars.begin(), nonlocal_scalars.end(), sym) ==
+                nonlocal_scalars.end() ) {
+            nonlocal_scalars.push_back(sym);
+        }
     }
 
-    bool is_vector_copy(ASR::stmt_t* x, Vec<ASR::expr_t*>& arrays) {
-        if( !ASR::is_a<ASR::Assignment_t>(*x) ) {
+    // Index of the vectorised dimension (the first one, which is contiguous
+    // in memory in the array descriptors of the backends): the loop
+    // variable or the loop variable plus or minus a scalar
+    bool is_loop_index(ASR::expr_t* x) {
+        if( is_loop_var(x) ) {
+            return true;
+        }
+        if( !is_a<ASR::IntegerBinOp_t>(*x) ) {
+            return false;
+        }
+        ASR::IntegerBinOp_t* binop = down_cast<ASR::IntegerBinOp_t>(x);
+        if( binop->m_op != ASR::binopType::Add &&
+            binop->m_op != ASR::binopType::Sub ) {
             return false;
         }
-        ASR::Assignment_t* x_assignment = ASR::down_cast<ASR::Assignment_t>(x);
-        ASR::expr_t* target = x_assignment->m_target;
-        ASR::expr_t* value = x_assignment->m_value;
-        if( !ASR::is_a<ASR::ArrayItem_t>(*target) ||
-            !ASR::is_a<ASR::ArrayItem_t>(*value) ) {
+        if( is_loop_var(binop->m_left) ) {
+            return is_invariant_index(binop->m_right);
+        }
+        return binop->m_op == ASR::binopType::Add &&
+               is_loop_var(binop->m_right) &&
+               is_invariant_index(binop->m_left);
+    }
+
+    bool is_invariant_index(ASR::expr_t* x) {
+        if( is_a<ASR::IntegerConstant_t>(*x) ) {
+            return true;
+        }
+        if( !is_a<ASR::Var_t>(*x) || is_loop_var(x) ) {
             return false;
         }
-        ASR::ArrayItem_t* target_array_ref = ASR::down_cast<ASR::ArrayItem_t>(target);
-        ASR::ArrayItem_t* value_array_ref = ASR::down_cast<ASR::ArrayItem_t>(value);
-        if( target_array_ref->m_args->m_left ||
-            target_array_ref->m_args->m_step ||
-            value_array_ref->m_args->m_left ||
-            value_array_ref->m_args->m_step ) {
+        ASR::symbol_t* sym = down_cast<ASR::Var_t>(x)->m_v;
+        if( !is_scalar_type(ASRUtils::symbol_type(sym)) ) {
             return false;
         }
-        arrays.push_back(al, target_array_ref->m_v);
-        arrays.push_back(al, value_array_ref->m_v);
+        add_scalar(sym, false);
+        index_scalars.insert(sym);
         return true;
     }
 
-    int64_t select_vector_instruction_size() {
-        return avx512;
-    }
-
-    int64_t get_vector_length(ASR::ttype_t* type) {
-        int kind = ASRUtils::extract_kind_from_ttype_t(type);
-        int64_t instruction_length = select_vector_instruction_size();
-        // TODO: Add check for divisibility and raise error if needed.
-        return instruction_length/(kind * 8);
-    }
-
-    void get_vector_intrinsic(ASR::stmt_t* loop_stmt, ASR::expr_t* index,
-                              ASR::expr_t*& vector_length,
-                              Vec<ASR::stmt_t*>& vectorised_loop_body) {
-        LFORTRAN_ASSERT(vectorised_loop_body.reserve_called);
-        Vec<ASR::expr_t*> arrays;
-        arrays.reserve(al, 2);
-        if( is_vector_copy(loop_stmt, arrays) ) {
-            ASR::expr_t *target_sym = arrays[0], *value_sym = arrays[1];
-            ASR::ttype_t* target_type = ASRUtils::expr_type(target_sym);
-            int64_t vector_length_int = get_vector_length(target_type);
-            vector_length = ASRUtils::EXPR(ASR::make_IntegerConstant_t(al, loop_stmt->base.loc,
-                                vector_length_int, ASRUtils::expr_type(index)));
-            ASR::expr_t* start = ASRUtils::EXPR(ASR::make_IntegerBinOp_t(al, loop_stmt->base.loc, index, ASR::binopType::Mul,
-                                        vector_length, ASRUtils::expr_type(index), nullptr));
-            ASR::expr_t* one = ASRUtils::EXPR(ASR::make_IntegerConstant_t(al, loop_stmt->base.loc,
-                                    1, ASRUtils::expr_type(index)));
-            ASR::expr_t* next_index = ASRUtils::EXPR(ASR::make_IntegerBinOp_t(al, loop_stmt->base.loc, index, ASR::binopType::Add,
-                                            one, ASRUtils::expr_type(index), nullptr));
-            ASR::expr_t* end = ASRUtils::EXPR(ASR::make_IntegerBinOp_t(al, loop_stmt->base.loc, next_index, ASR::binopType::Mul,
-                                        vector_length, ASRUtils::expr_type(index), nullptr));
-            vectorised_loop_body.push_back(al, PassUtils::get_vector_copy(target_sym, value_sym, start,
-                end, one, vector_length,
-                al, unit,
-                current_scope, loop_stmt->base.loc));
-            return ;
+    bool is_vectorisable_array_item(ASR::ArrayItem_t* x, bool written) {
+        if( !is_a<ASR::Var_t>(*x->m_v) ||
+            !is_scalar_type(x->m_type) || is_a<ASR::Logical_t>(*x->m_type) ) {
+            return false;
+        }
+        for( size_t i = 0; i < x->n_args; i++ ) {
+            if( x->m_args[i].m_left || x->m_args[i].m_step ||
+                x->m_args[i].m_right == nullptr ) {
+                return false;
+            }
+            bool is_index = (i == 0 && is_loop_index(x->m_args[i].m_right));
+            if( !is_index && !is_invariant_index(x->m_args[i].m_right) ) {
+                return false;
+            }
+            if( i == 0 && written && !is_loop_var(x->m_args[i].m_right) ) {
+                return false;
+            }
+        }
+        ASR::symbol_t* array = down_cast<ASR::Var_t>(x->m_v)->m_v;
+        array_items[array].push_back(x);
+        if( written ) {
+            written_arrays.insert(array);
+        }
+        return true;
+    }
+
+    bool is_vectorisable_expr(ASR::expr_t* x) {
+        switch( x->type ) {
+            case ASR::exprType::IntegerConstant:
+            case ASR::exprType::RealConstant:
+            case ASR::exprType::LogicalConstant: {
+                return true;
+            }
+            case ASR::exprType::Var: {
+                ASR::symbol_t* sym = down_cast<ASR::Var_t>(x)->m_v;
+                if( !is_scalar_type(ASRUtils::symbol_type(sym)) ) {
+                    return false;
+                }
+                if( sym != loop_var ) {
+                    add_scalar(sym, false);
+                }
+                return true;
+            }
+            case ASR::exprType::ArrayItem: {
+                return is_vectorisable_array_item(down_cast<ASR::ArrayItem_t>(x), false);
+            }
+            case ASR::exprType::IntegerBinOp: {
+                ASR::IntegerBinOp_t* binop = down_cast<ASR::IntegerBinOp_t>(x);
+                return (binop->m_op == ASR::binopType::Add ||
+                        binop->m_op == ASR::binopType::Sub ||
+                        binop->m_op == ASR::binopType::Mul) &&
+                       is_vectorisable_expr(binop->m_left) &&
+                       is_vectorisable_expr(binop->m_right);
+            }
+            case ASR::exprType::RealBinOp: {
+                ASR::RealBinOp_t* binop = down_cast<ASR::RealBinOp_t>(x);
+                return binop->m_op != ASR::binopType::Pow &&
+                       is_vectorisable_expr(binop->m_left) &&
+                       is_vectorisable_expr(binop->m_right);
+            }
+            case ASR::exprType::IntegerUnaryMinus: {
+                return is_vectorisable_expr(down_cast<ASR::IntegerUnaryMinus_t>(x)->m_arg);
+            }
+            case ASR::exprType::RealUnaryMinus: {
+                return is_vectorisable_expr(down_cast<ASR::RealUnaryMinus_t>(x)->m_arg);
+            }
+            case ASR::exprType::IntegerCompare: {
+                ASR::IntegerCompare_t* cmp = down_cast<ASR::IntegerCompare_t>(x);
+                return is_vectorisable_expr(cmp->m_left) &&
+                       is_vectorisable_expr(cmp->m_right);
+            }
+            case ASR::exprType::RealCompare: {
+                ASR::RealCompare_t* cmp = down_cast<ASR::RealCompare_t>(x);
+                if( is_a<ASR::Var_t>(*cmp->m_left) ) {
+                    compared_scalars.insert(down_cast<ASR::Var_t>(cmp->m_left)->m_v);
+                }
+                if( is_a<ASR::Var_t>(*cmp->m_right) ) {
+                    compared_scalars.insert(down_cast<ASR::Var_t>(cmp->m_right)->m_v);
+                }
+                return is_vectorisable_expr(cmp->m_left) &&
+                       is_vectorisable_expr(cmp->m_right);
+            }
+            case ASR::exprType::LogicalBinOp: {
+                ASR::LogicalBinOp_t* binop = down_cast<ASR::LogicalBinOp_t>(x);
+                return (binop->m_op == ASR::logicalbinopType::And ||
+                        binop->m_op == ASR::logicalbinopType::Or) &&
+                       is_vectorisable_expr(binop->m_left) &&
+                       is_vectorisable_expr(binop->m_right);
+            }
+            case ASR::exprType::LogicalNot: {
+                return is_vectorisable_expr(down_cast<ASR::LogicalNot_t>(x)->m_arg);
+            }
+            case ASR::exprType::Cast: {
+                ASR::Cast_t* cast = down_cast<ASR::Cast_t>(x);
+                return (cast->m_kind == ASR::cast_kindType::IntegerToReal ||
+                        cast->m_kind == ASR::cast_kindType::RealToReal ||
+                        cast->m_kind == ASR::cast_kindType::IntegerToInteger ||
+                        cast->m_kind == ASR::cast_kindType::RealToInteger) &&
+                       is_vectorisable_expr(cast->m_arg);
+            }
+            case ASR::exprType::IfExp: {
+                ASR::IfExp_t* ifexp = down_cast<ASR::IfExp_t>(x);
+                return is_vectorisable_expr(ifexp->m_test) &&
+                       is_vectorisable_expr(ifexp->m_body) &&
+                       is_vectorisable_expr(ifexp->m_orelse);
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+
+    // An `if` statement that assigns to the same array element in both
+    // branches, which is converted to a conditional expression
+    bool is_select(ASR::If_t* x) {
+        if( x->n_body != 1 || x->n_orelse != 1 ||
+            !is_a<ASR::Assignment_t>(*x->m_body[0]) ||
+            !is_a<ASR::Assignment_t>(*x->m_orelse[0]) ) {
+            return false;
+        }
+        ASR::expr_t* body_target = down_cast<ASR::Assignment_t>(x->m_body[0])->m_target;
+        ASR::expr_t* orelse_target = down_cast<ASR::Assignment_t>(x->m_orelse[0])->m_target;
+        if( !is_a<ASR::ArrayItem_t>(*body_target) ||
+            !is_a<ASR::ArrayItem_t>(*orelse_target) ) {
+            return false;
+        }
+        ASR::ArrayItem_t* body_item = down_cast<ASR::ArrayItem_t>(body_target);
+        ASR::ArrayItem_t* orelse_item = down_cast<ASR::ArrayItem_t>(orelse_target);
+        if( !is_a<ASR::Var_t>(*body_item->m_v) || !is_a<ASR::Var_t>(*orelse_item->m_v) ||
+            down_cast<ASR::Var_t>(body_item->m_v)->m_v !=
+                down_cast<ASR::Var_t>(orelse_item->m_v)->m_v ||
+            body_item->n_args != orelse_item->n_args ) {
+            return false;
+        }
+        for( size_t i = 0; i < body_item->n_args; i++ ) {
+            if( !body_item->m_args[i].m_right || !orelse_item->m_args[i].m_right ||
+                !is_same_index(body_item->m_args[i].m_right,
+                               orelse_item->m_args[i].m_right) ) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // The array elements are only assigned unconditionally (or in both
+    // branches of an `if`), as conditional stores are not vectorised
+    bool is_vectorisable_stmt(ASR::stmt_t* x, bool conditional) {
+        if( is_a<ASR::Assignment_t>(*x) ) {
+            ASR::Assignment_t* assignment = down_cast<ASR::Assignment_t>(x);
+            if( assignment->m_overloaded ) {
+                return false;
+            }
+            ASR::expr_t* target = assignment->m_target;
+            if( is_a<ASR::Var_t>(*target) ) {
+                ASR::symbol_t* sym = down_cast<ASR::Var_t>(target)->m_v;
+                if( sym == loop_var || !is_scalar_type(ASRUtils::symbol_type(sym)) ) {
+                    return false;
+                }
+                add_scalar(sym, true);
+            } else if( conditional || !is_a<ASR::ArrayItem_t>(*target) ||
+                       !is_vectorisable_array_item(
+                            down_cast<ASR::ArrayItem_t>(target), true) ) {
+                return false;
+            }
+            return is_vectorisable_expr(assignment->m_value);
+        }
+        if( is_a<ASR::If_t>(*x) ) {
+            ASR::If_t* if_stmt = down_cast<ASR::If_t>(x);
+            if( !is_vectorisable_expr(if_stmt->m_test) ) {
+                return false;
+            }
+            if( !conditional && is_select(if_stmt) ) {
+                return is_vectorisable_stmt(if_stmt->m_body[0], false) &&
+                       is_vectorisable_stmt(if_stmt->m_orelse[0], false);
+            }
+            for( size_t i = 0; i < if_stmt->n_body; i++ ) {
+                if( !is_vectorisable_stmt(if_stmt->m_body[i], true) ) {
+                    return false;
+                }
+            }
+            for( size_t i = 0; i < if_stmt->n_orelse; i++ ) {
+                if( !is_vectorisable_stmt(if_stmt->m_orelse[i], true) ) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+
+    bool is_same_index(ASR::expr_t* a, ASR::expr_t* b) {
+        if( is_a<ASR::Var_t>(*a) && is_a<ASR::Var_t>(*b) ) {
+            return down_cast<ASR::Var_t>(a)->m_v == down_cast<ASR::Var_t>(b)->m_v;
+        }
+        if( is_a<ASR::IntegerConstant_t>(*a) && is_a<ASR::IntegerConstant_t>(*b) ) {
+            return down_cast<ASR::IntegerConstant_t>(a)->m_n ==
+                   down_cast<ASR::IntegerConstant_t>(b)->m_n;
+        }
+        return false;
+    }
+
+    // An array written in the loop must be accessed at the same element in
+    // every statement, so that there are no dependencies between iterations
+    bool has_loop_carried_dependencies() {
+        for( ASR::symbol_t* array: written_arrays ) {
+            std::vector<ASR::ArrayItem_t*>& items = array_items[array];
+            for( ASR::ArrayItem_t* item: items ) {
+                if( item->n_args != items[0]->n_args ) {
+                    return true;
+                }
+                for( size_t i = 0; i < item->n_args; i++ ) {
+                    if( !is_same_index(item->m_args[i].m_right,
+                                       items[0]->m_args[i].m_right) ) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    void replace_scalars(ASR::expr_t*& x) {
+        switch( x->type ) {
+            case ASR::exprType::Var: {
+                ASR::symbol_t* sym = down_cast<ASR::Var_t>(x)->m_v;
+                if( scalar_copies.find(sym) != scalar_copies.end() ) {
+                    x = ASRUtils::EXPR(ASR::make_Var_t(al, x->base.loc,
+                            scalar_copies[sym]));
+                }
+                break;
+            }
+            case ASR::exprType::ArrayItem: {
+                ASR::ArrayItem_t* item = down_cast<ASR::ArrayItem_t>(x);
+                for( size_t i = 0; i < item->n_args; i++ ) {
+                    replace_scalars(item->m_args[i].m_right);
+                }
+                break;
+            }
+            case ASR::exprType::IntegerBinOp: {
+                ASR::IntegerBinOp_t* binop = down_cast<ASR::IntegerBinOp_t>(x);
+                replace_scalars(binop->m_left);
+                replace_scalars(binop->m_right);
+                break;
+            }
+            case ASR::exprType::RealBinOp: {
+                ASR::RealBinOp_t* binop = down_cast<ASR::RealBinOp_t>(x);
+                replace_scalars(binop->m_left);
+                replace_scalars(binop->m_right);
+                break;
+            }
+            case ASR::exprType::IntegerUnaryMinus: {
+                replace_scalars(down_cast<ASR::IntegerUnaryMinus_t>(x)->m_arg);
+                break;
+            }
+            case ASR::exprType::RealUnaryMinus: {
+                replace_scalars(down_cast<ASR::RealUnaryMinus_t>(x)->m_arg);
+                break;
+            }
+            case ASR::exprType::IntegerCompare: {
+                ASR::IntegerCompare_t* cmp = down_cast<ASR::IntegerCompare_t>(x);
+                replace_scalars(cmp->m_left);
+                replace_scalars(cmp->m_right);
+                break;
+            }
+            case ASR::exprType::RealCompare: {
+                ASR::RealCompare_t* cmp = down_cast<ASR::RealCompare_t>(x);
+                replace_scalars(cmp->m_left);
+                replace_scalars(cmp->m_right);
+                break;
+            }
+            case ASR::exprType::LogicalBinOp: {
+                ASR::LogicalBinOp_t* binop = down_cast<ASR::LogicalBinOp_t>(x);
+                replace_scalars(binop->m_left);
+                replace_scalars(binop->m_right);
+                break;
+            }
+            case ASR::exprType::LogicalNot: {
+                replace_scalars(down_cast<ASR::LogicalNot_t>(x)->m_arg);
+                break;
+            }
+            case ASR::exprType::Cast: {
+                replace_scalars(down_cast<ASR::Cast_t>(x)->m_arg);
+                break;
+            }
+            case ASR::exprType::IfExp: {
+                ASR::IfExp_t* ifexp = down_cast<ASR::IfExp_t>(x);
+                replace_scalars(ifexp->m_test);
+                replace_scalars(ifexp->m_body);
+                replace_scalars(ifexp->m_orelse);
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+    }
+
+    void replace_scalars(ASR::stmt_t* x) {
+        if( is_a<ASR::Assignment_t>(*x) ) {
+            ASR::Assignment_t* assignment = down_cast<ASR::Assignment_t>(x);
+            replace_scalars(assignment->m_target);
+            replace_scalars(assignment->m_value);
+        } else if( is_a<ASR::If_t>(*x) ) {
+            ASR::If_t* if_stmt = down_cast<ASR::If_t>(x);
+            replace_scalars(if_stmt->m_test);
+            for( size_t i = 0; i < if_stmt->n_body; i++ ) {
+                replace_scalars(if_stmt->m_body[i]);
+            }
+            for( size_t i = 0; i < if_stmt->n_orelse; i++ ) {
+                replace_scalars(if_stmt->m_orelse[i]);
+            }
+        }
+    }
+
+    bool is_vectorisable_loop(const ASR::DoLoop_t& x) {
+        loop_var = nullptr;
+        nonlocal_scalars.clear();
+        written_scalars.clear();
+        index_scalars.clear();
+        compared_scalars.clear();
+        array_items.clear();
+        written_arrays.clear();
+        if( x.n_body == 0 || !is_a<ASR::Var_t>(*x.m_head.m_v) ||
+            !is_a<ASR::Integer_t>(*ASRUtils::expr_type(x.m_head.m_v)) ) {
+            return false;
+        }
+        int64_t increment = 1;
+        if( x.m_head.m_increment && (!ASRUtils::extract_value(
+                ASRUtils::expr_value(x.m_head.m_increment), increment) ||
+                increment != 1) ) {
+            return false;
+        }
+        loop_var = down_cast<ASR::Var_t>(x.m_head.m_v)->m_v;
+        for( size_t i = 0; i < x.n_body; i++ ) {
+            if( !is_vectorisable_stmt(x.m_body[i], false) ) {
+                return false;
+            }
         }
+        for( ASR::symbol_t* sym: index_scalars ) {
+            if( written_scalars.find(sym) != written_scalars.end() ) {
+                return false;
+            }
+        }
+        // Floating point minimum and maximum reductions (a real scalar
+        // compared and written in the loop) are only vectorised by LLVM if
+        // the whole function ignores NaNs and signed zeros
+        for( ASR::symbol_t* sym: compared_scalars ) {
+            if( written_scalars.find(sym) != written_scalars.end() ) {
+                return false;
+            }
+        }
+        // Only loops that access arrays are worth vectorising
+        return !array_items.empty() && !has_loop_carried_dependencies();
     }
 
     void vectorise_loop(const ASR::DoLoop_t& x) {
-        // Do Vectorisation of Loop inside this function
-        ASR::expr_t* loop_start = x.m_head.m_start;
-        ASR::expr_t* loop_end = x.m_head.m_end;
-        ASR::expr_t* loop_inc = x.m_head.m_increment;
-        ASR::expr_t* loop_start_value = ASRUtils::expr_value(loop_start);
-        ASR::expr_t* loop_end_value = ASRUtils::expr_value(loop_end);
-        ASR::expr_t* loop_inc_value = ASRUtils::expr_value(loop_inc);
-        if( !ASRUtils::is_value_constant(loop_start_value) ||
-            !ASRUtils::is_value_constant(loop_end_value) ||
-            !ASRUtils::is_value_constant(loop_inc_value) ) {
-            // Skip vectorisation of variable sized loops
-            return ;
+        Location loc = x.base.base.loc;
+        scalar_copies.clear();
+        Vec<ASR::stmt_t*> copy_out;
+        copy_out.reserve(al, written_scalars.size());
+        for( ASR::symbol_t* sym: nonlocal_scalars ) {
+            std::string name = current_scope->get_unique_name(
+                "~" + std::string(ASRUtils::symbol_name(sym)) + "_vec");
+            ASR::expr_t* copy = PassUtils::create_auxiliary_variable(loc, name,
+                al, current_scope, ASRUtils::symbol_type(sym));
+            ASR::expr_t* original = ASRUtils::EXPR(ASR::make_Var_t(al, loc, sym));
+            scalar_copies[sym] = down_cast<ASR::Var_t>(copy)->m_v;
+            pass_result.push_back(al, ASRUtils::STMT(ASR::make_Assignment_t(al,
+                loc, copy, original, nullptr)));
+            if( written_scalars.find(sym) != written_scalars.end() ) {
+                copy_out.push_back(al, ASRUtils::STMT(ASR::make_Assignment_t(al,
+                    loc, original, copy, nullptr)));
+            }
         }
-        ASR::stmt_t* loop_stmt = x.m_body[0];
-        int64_t loop_start_int = -1, loop_end_int = -1, loop_inc_int = -1;
-        ASRUtils::extract_value(loop_start_value, loop_start_int);
-        ASRUtils::extract_value(loop_end_value, loop_end_int);
-        ASRUtils::extract_value(loop_inc_value, loop_inc_int);
-        int64_t loop_size = (loop_end_int - loop_start_int) / loop_inc_int + 1;
-        ASR::expr_t* vector_length = nullptr;
-        Vec<ASR::stmt_t*> vectorised_loop_body;
-        vectorised_loop_body.reserve(al, x.n_body);
-        get_vector_intrinsic(loop_stmt, x.m_head.m_v,
-                             vector_length, vectorised_loop_body);
-        if( !vector_length ) {
-            return ;
+        Vec<ASR::stmt_t*> body;
+        body.reserve(al, x.n_body);
+        for( size_t i = 0; i < x.n_body; i++ ) {
+            ASR::stmt_t* stmt = x.m_body[i];
+            if( is_a<ASR::If_t>(*stmt) && is_select(down_cast<ASR::If_t>(stmt)) ) {
+                ASR::If_t* if_stmt = down_cast<ASR::If_t>(stmt);
+                ASR::Assignment_t* body_assignment = down_cast<ASR::Assignment_t>(if_stmt->m_body[0]);
+                ASR::Assignment_t* orelse_assignment = down_cast<ASR::Assignment_t>(if_stmt->m_orelse[0]);
+                ASR::expr_t* value = ASRUtils::EXPR(ASR::make_IfExp_t(al, stmt->base.loc,
+                    if_stmt->m_test, body_assignment->m_value, orelse_assignment->m_value,
+                    ASRUtils::expr_type(body_assignment->m_target), nullptr));
+                stmt = ASRUtils::STMT(ASR::make_Assignment_t(al, stmt->base.loc,
+                    body_assignment->m_target, value, nullptr));
+            }
+            replace_scalars(stmt);
+            body.push_back(al, stmt);
+        }
+        pass_result.push_back(al, ASRUtils::STMT(ASR::make_DoConcurrentLoop_t(al,
+            loc, x.m_head, body.p, body.size())));
+        for( size_t i = 0; i < copy_out.size(); i++ ) {
+            pass_result.push_back(al, copy_out[i]);
         }
-        ASR::do_loop_head_t vectorised_loop_head;
-        vectorised_loop_head.m_start = loop_start;
-        int64_t vector_length_int = -1;
-        ASRUtils::extract_value(vector_length, vector_length_int);
-        // TODO: Add tests for loop sizes not divisible by vector_length.
-        vectorised_loop_head.m_end = ASRUtils::EXPR(ASR::make_IntegerConstant_t(al, x.m_head.m_v->base.loc,
-                                        loop_size/vector_length_int - 1, ASRUtils::expr_type(x.m_head.m_v)));
-        // TODO: Update this for increments other 1.
-        ASR::expr_t* one = ASRUtils::EXPR(ASR::make_IntegerConstant_t(al, loop_stmt->base.loc,
-                                    1, ASRUtils::expr_type(x.m_head.m_v)));
-        vectorised_loop_head.m_increment = one;
-        vectorised_loop_head.m_v = x.m_head.m_v;
-        vectorised_loop_head.loc = x.m_head.loc;
-
-        ASR::stmt_t* vectorised_loop = ASRUtils::STMT(ASR::make_DoLoop_t(al, x.base.base.loc,
-                                            vectorised_loop_head, vectorised_loop_body.p,
-                                            vectorised_loop_body.size()));
-        pass_result.push_back(al, vectorised_loop);
     }
 
     void visit_DoLoop(const ASR::DoLoop_t& x) {
-        from_loop_vectorise = true;
-        if( x.n_body == 1 ) {
-            // Vectorise
-            if( is_loop(*x.m_body[0]) ) {
-                from_loop_vectorise = false;
-                visit_stmt(*x.m_body[0]);
-                return ;
-            }
+        if( is_vectorisable_loop(x) ) {
             vectorise_loop(x);
+            return ;
         }
-        from_loop_vectorise = false;
+        // Look for the innermost loops
+        PassUtils::PassVisitor<LoopVectoriseVisitor>::visit_DoLoop(x);
+    }
+
+    void visit_WhileLoop(const ASR::WhileLoop_t& x) {
+        ASR::WhileLoop_t& xx = const_cast<ASR::WhileLoop_t&>(x);
+        transform_stmts(xx.m_body, xx.n_body);
+    }
+
+    void visit_If(const ASR::If_t& x) {
+        ASR::If_t& xx = const_cast<ASR::If_t&>(x);
+        transform_stmts(xx.m_body, xx.n_body);
+        transform_stmts(xx.m_orelse, xx.n_orelse);
     }
 
 };
 
 void pass_loop_vectorise(Allocator &al, ASR::TranslationUnit_t &unit,
-                         const LCompilers::PassOptions& pass_options) {
-    std::string rl_path = pass_options.runtime_library_dir;
-    LoopVectoriseVisitor v(al, unit, rl_path);
+                         const LCompilers::PassOptions& /*pass_options*/) {
+    LoopVectoriseVisitor v(al);
     v.visit_TranslationUnit(unit);
     PassUtils::UpdateDependenciesVisitor u(al);
     u.visit_TranslationUnit(unit);
@@ -36,6 +36,7 @@
 #include <libasr/pass/for_all.h>
 #include <libasr/pass/select_case.h>
 #include <libasr/pass/loop_vectorise.h>
+#include <libasr/pass/array_kernels.h>
 #include <libasr/pass/update_array_dim_intrinsic_calls.h>
 #include <libasr/pass/pass_array_by_data.h>
 #include <libasr/pass/pass_list_expr.h>
@@ -43,6 +44,7 @@
 #include <libasr/pass/subroutine_from_function.h>
 #include <libasr/asr_verify.h>
 
+#include <chrono>
 #include <map>
 #include <vector>
 
@@ -51,6 +53,10 @@ namespace LCompilers {
     typedef void (*pass_function)(Allocator&, LFortran::ASR::TranslationUnit_t&,
                                   const LCompilers::PassOptions&);
 
+    typedef void (*symbol_pass_function)(Allocator&,
+        LFortran::ASR::TranslationUnit_t&, LFortran::ASR::symbol_t&,
+        const LCompilers::PassOptions&);
+
     class PassManager {
         private:
 
@@ -77,6 +83,7 @@ namespace LCompilers {
             {"forall", &LFortran::pass_replace_forall},
             {"select_case", &LFortran::pass_replace_select_case},
             {"loop_vectorise", &LFortran::pass_loop_vectorise},
+            {"array_kernels", &LFortran::pass_replace_array_kernels},
             {"array_dim_intrinsics_update", &LFortran::pass_update_array_dim_intrinsic_calls},
             {"pass_list_expr", &LFortran::pass_list_expr},
             {"pass_array_by_data", &LFortran::pass_array_by_data},
@@ -84,20 +91,88 @@ namespace LCompilers {
             {"pass_compare", &LFortran::pass_compare}
         };
 
+        // Passes that only rewrite the body of the symbol they visit. A run
+        // of consecutive such passes is fused: all of them are applied to
+        // one function before moving on to the next, so the whole pipeline
+        // walks the ASR once instead of once per pass.
+        std::map<std::string, symbol_pass_function> _fusable_passes_db = {
+            {"do_loops", &LFortran::pass_replace_do_loops_symbol},
+            {"forall", &LFortran::pass_replace_forall_symbol},
+            {"dead_code_removal", &LFortran::pass_dead_code_removal_symbol},
+            {"select_case", &LFortran::pass_replace_select_case_symbol},
+            {"print_arr", &LFortran::pass_replace_print_arr_symbol},
+            {"print_list", &LFortran::pass_replace_print_list_symbol},
+            {"flip_sign", &LFortran::pass_replace_flip_sign_symbol},
+            {"sign_from_value", &LFortran::pass_replace_sign_from_value_symbol},
+            {"div_to_mul", &LFortran::pass_replace_div_to_mul_symbol},
+            {"fma", &LFortran::pass_replace_fma_symbol}
+        };
+
         bool is_fast;
         bool apply_default_passes;
 
+        bool is_fusable(const std::string &pass) {
+            return _fusable_passes_db.find(pass) != _fusable_passes_db.end();
+        }
+
+        // Applies the fusable passes `group` to every function, in the order
+        // of `group`, with one walk over the symbols of `asr`
+        void _apply_fused_passes(Allocator& al, LFortran::ASR::TranslationUnit_t* asr,
+                                 const std::vector<std::string>& group,
+                                 PassOptions &pass_options) {
+            std::vector<symbol_pass_function> fns;
+            for (auto &pass: group) {
+                fns.push_back(_fusable_passes_db[pass]);
+            }
+            for (auto &a: asr->m_global_scope->get_scope()) {
+                if (LFortran::ASR::is_a<LFortran::ASR::Module_t>(*a.second)) {
+                    LFortran::ASR::Module_t *m = LFortran::ASR::down_cast<
+                        LFortran::ASR::Module_t>(a.second);
+                    for (auto &b: m->m_symtab->get_scope()) {
+                        for (auto fn: fns) fn(al, *asr, *b.second, pass_options);
+                    }
+                } else {
+                    for (auto fn: fns) fn(al, *asr, *a.second, pass_options);
+                }
+            }
+        }
+
         void _apply_passes(Allocator& al, LFortran::ASR::TranslationUnit_t* asr,
                            std::vector<std::string>& passes, PassOptions &pass_options,
                            LFortran::diag::Diagnostics &diagnostics) {
-            for (size_t i = 0; i < passes.size(); i++) {
+            size_t i = 0;
+            while (i < passes.size()) {
                 // TODO: rework the whole pass manager: construct the passes
                 // ahead of time (not at the last minute), and remove this much
                 // earlier
                 // Note: this is not enough for rtlib, we also need to include
                 // it
-                if (rtlib && passes[i] == "unused_functions") continue;
-                _passes_db[passes[i]](al, *asr, pass_options);
+                if (rtlib && passes[i] == "unused_functions") {
+                    i++;
+                    continue;
+                }
+                std::string name = passes[i];
+                auto pass_start = std::chrono::high_resolution_clock::now();
+                if (fuse_passes && is_fusable(passes[i])) {
+                    std::vector<std::string> group;
+                    while (i < passes.size() && is_fusable(passes[i])) {
+                        group.push_back(passes[i]);
+                        i++;
+                    }
+                    for (size_t j = 1; j < group.size(); j++) {
+                        name += "+" + group[j];
+                    }
+                    _apply_fused_passes(al, asr, group, pass_options);
+                } else {
+                    _passes_db[passes[i]](al, *asr, pass_options);
+                    i++;
+                }
+                auto pass_end = std::chrono::high_resolution_clock::now();
+                if (time_report) {
+                    pass_times.push_back(std::make_pair(name,
+                        std::chrono::duration<double, std::milli>(
+                            pass_end - pass_start).count()));
+                }
             #if defined(WITH_LFORTRAN_ASSERT)
                 if (!LFortran::asr_verify(*asr, true, diagnostics)) {
                     std::cerr << diagnostics.render2();
@@ -111,6 +186,14 @@ namespace LCompilers {
 
         bool rtlib=false;
 
+        // If set, the time (in ms) spent in every pass applied is appended
+        // to `pass_times`
+        bool time_report=false;
+        std::vector<std::pair<std::string, double>> pass_times;
+
+        // Fuse runs of consecutive function-local passes into one traversal
+        bool fuse_passes=true;
+
         PassManager(): is_fast{false}, apply_default_passes{false} {
             _passes = {
                 "global_stmts",
@@ -141,6 +224,7 @@ namespace LCompilers {
                 "array_op",
                 "print_arr",
                 "print_list",
+                "array_kernels",
                 "loop_vectorise",
                 "loop_unroll",
                 "array_dim_intrinsics_update",
@@ -152,7 +236,6 @@ namespace LCompilers {
                 "flip_sign",
                 "sign_from_value",
                 "div_to_mul",
-                "fma",
                 "inline_function_calls"
             };
 
@@ -205,6 +288,16 @@ namespace LCompilers {
             }
         }
 
+        // Returns the passes that `apply_passes` will run, in order
+        std::vector<std::string> get_passes() {
+            if( !_user_defined_passes.empty() ) {
+                return _user_defined_passes;
+            } else if( apply_default_passes ) {
+                return is_fast ? _with_optimization_passes : _passes;
+            }
+            return {};
+        }
+
         void use_optimization_passes() {
             is_fast = true;
         }
@@ -64,11 +64,6 @@ namespace LFortran {
                                          SymbolTable*& current_scope, Location& loc,
                                          const std::function<void (const std::string &, const Location &)> err);
 
-        ASR::stmt_t* get_vector_copy(ASR::expr_t* array0, ASR::expr_t* array1, ASR::expr_t* start,
-            ASR::expr_t* end, ASR::expr_t* step, ASR::expr_t* vector_length,
-            Allocator& al, ASR::TranslationUnit_t& unit,
-            SymbolTable*& global_scope, Location& loc);
-
         Vec<ASR::stmt_t*> replace_doloop(Allocator &al, const ASR::DoLoop_t &loop,
                                          int comp=-1);
 
@@ -76,6 +71,23 @@ namespace LFortran {
             return ASR::is_a<ASR::Struct_t>(*ASRUtils::expr_type(var));
         }
 
+        // Returns true if the `--profile-use` profile found `x` cold, the
+        // profile has the names of the LLVM functions
+        static inline bool is_cold_function(const ASR::Function_t &x,
+                const std::set<std::string> &cold_functions) {
+            if (cold_functions.empty()) {
+                return false;
+            }
+            std::string name = x.m_name;
+            ASR::asr_t *owner = x.m_symtab->parent->asr_owner;
+            if (owner && ASR::is_a<ASR::symbol_t>(*owner) &&
+                    ASR::is_a<ASR::Module_t>(*ASR::down_cast<ASR::symbol_t>(owner))) {
+                name = "__module_" + std::string(
+                    ASR::down_cast2<ASR::Module_t>(owner)->m_name) + "_" + name;
+            }
+            return cold_functions.find(name) != cold_functions.end();
+        }
+
         template <class Struct>
         class PassVisitor: public ASR::BaseWalkVisitor<Struct> {
 
@@ -191,6 +203,12 @@ namespace LFortran {
                     transform_stmts(xx.m_body, xx.n_body);
                 }
 
+                void visit_DoConcurrentLoop(const ASR::DoConcurrentLoop_t& x) {
+                    self().visit_do_loop_head(x.m_head);
+                    ASR::DoConcurrentLoop_t& xx = const_cast<ASR::DoConcurrentLoop_t&>(x);
+                    transform_stmts(xx.m_body, xx.n_body);
+                }
+
         };
 
         template <class Struct>
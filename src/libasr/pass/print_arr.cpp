@@ -85,5 +85,11 @@ void pass_replace_print_arr(Allocator &al, ASR::TranslationUnit_t &unit,
     v.visit_TranslationUnit(unit);
 }
 
+void pass_replace_print_arr_symbol(Allocator &al, ASR::TranslationUnit_t &/*unit*/,
+                                   ASR::symbol_t &sym, const LCompilers::PassOptions& pass_options) {
+    PrintArrVisitor v(al, pass_options.runtime_library_dir);
+    v.visit_symbol(sym);
+}
+
 
 } // namespace LFortran
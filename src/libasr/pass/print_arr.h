@@ -9,6 +9,11 @@ namespace LFortran {
     void pass_replace_print_arr(Allocator &al, ASR::TranslationUnit_t &unit,
                                 const LCompilers::PassOptions& pass_options);
 
+    // Applies the pass to the symbol `sym` of `unit` only, so that it can be
+    // fused with other passes (see `PassManager`)
+    void pass_replace_print_arr_symbol(Allocator &al, ASR::TranslationUnit_t &unit,
+                                       ASR::symbol_t &sym, const LCompilers::PassOptions& pass_options);
+
 } // namespace LFortran
 
 #endif // LFORTRAN_PASS_PRINT_ARR_H
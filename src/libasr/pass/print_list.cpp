@@ -206,4 +206,10 @@ void pass_replace_print_list(
     v.visit_TranslationUnit(unit);
 }
 
+void pass_replace_print_list_symbol(Allocator &al, ASR::TranslationUnit_t &/*unit*/,
+                                    ASR::symbol_t &sym, const LCompilers::PassOptions& pass_options) {
+    PrintListVisitor v(al, pass_options.runtime_library_dir);
+    v.visit_symbol(sym);
+}
+
 }  // namespace LFortran
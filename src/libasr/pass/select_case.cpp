@@ -6,6 +6,11 @@
 #include <libasr/pass/pass_utils.h>
 #include <libasr/pass/select_case.h>
 
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <vector>
+
 
 namespace LFortran {
 
@@ -46,8 +51,61 @@ to:
         ...
     end if
 
+If the cases of a select on an integer are constants (values and ranges) and
+there are at least `min_dispatch_cases` of them, the select is dispatched by a
+balanced binary search over the sorted cases instead:
+
+    if ( a < d ) then
+        if ( b <= a && a <= c ) then
+            ...
+        end if
+    else
+        if ( d <= a && a <= e ) then
+            ...
+        else if ( a == f ) then
+            ...
+        end if
+    end if
+
+If a case has several tests or there is a `case default`, a body would be
+reached from several leaves of the search, so the search only stores the
+index of the case and the bodies are dispatched on the index (which is dense).
+
+If `PassOptions::native_switch` is set, the selects with dense constant cases
+are kept: the backend emits a `switch` (LLVM, C) or a `br_table` (WASM), which
+is a jump table. A select is only kept if no case exits its enclosing loop,
+as the C backend emits `exit` as a `break`, which would leave the `switch`.
+
+The pass also turns the `if` chains that compare an integer variable with
+distinct constants into a select, which is how a Python program dispatches
+(an interpreter or a state machine):
+
+    if a == 1:              select case (a)
+        ...                     case (1)
+    elif a == 2 or a == 3:          ...
+        ...                     case (2, 3)
+    elif a == 4:                    ...
+        ...                     case (4)
+    else:                           ...
+        ...                     case default
+                                    ...
+                            end select
+
 */
 
+// The selects (and `if` chains) with fewer constant cases are lowered to an
+// `if` chain, a dispatch does not pay off
+const size_t min_dispatch_cases = 4;
+
+// The selects kept for the backend have at most `max_switch_values` case
+// values (ranges count all their values) and the values span at most
+// `max_switch_span_per_value` times as many integers (the size of the table)
+const int64_t max_switch_values = 1024;
+const int64_t max_switch_span_per_value = 4;
+
+// The leaves of the binary search test up to this many cases in a chain
+const size_t max_leaf_cases = 3;
+
 inline ASR::expr_t* gen_test_expr_CaseStmt(Allocator& al, const Location& loc, ASR::CaseStmt_t* Case_Stmt, ASR::expr_t* a_test) {
     ASR::expr_t* test_expr = nullptr;
     if( Case_Stmt->n_test == 1 ) {
@@ -131,26 +189,172 @@ void case_to_if(Allocator& al, const ASR::Select_t& x, ASR::expr_t* a_test, Vec<
     body.push_back(al, last_if_else);
 }
 
-Vec<ASR::stmt_t*> replace_selectcase(Allocator &al, const ASR::Select_t &select_case) {
-    ASR::expr_t *a = select_case.m_test;
-    Vec<ASR::stmt_t*> body;
-    case_to_if(al, select_case, a, body);
-    /*
-    std::cout << "Input:" << std::endl;
-    std::cout << pickle((ASR::asr_t&)loop);
-    std::cout << "Output:" << std::endl;
-    std::cout << pickle((ASR::asr_t&)*stmt1);
-    std::cout << pickle((ASR::asr_t&)*stmt2);
-    std::cout << "--------------" << std::endl;
-    */
-    return body;
+static bool is_constant(ASR::expr_t* x, int64_t &n) {
+    ASR::expr_t* value = ASRUtils::expr_value(x);
+    if( value && is_a<ASR::IntegerConstant_t>(*value) ) {
+        n = down_cast<ASR::IntegerConstant_t>(value)->m_n;
+        return true;
+    }
+    return false;
+}
+
+// A constant case `lo <= a <= hi` of the select, `idx` is the index of the
+// case statement. A missing end of a range is the limit of `int64_t`.
+struct CaseRange {
+    int64_t lo, hi;
+    size_t idx;
+};
+
+// Collects the cases of `x` sorted by their values. Returns false if `x` is
+// not on an integer, a case is not constant or two cases overlap.
+static bool get_case_ranges(const ASR::Select_t &x, std::vector<CaseRange> &ranges) {
+    if( !ASRUtils::is_integer(*ASRUtils::expr_type(x.m_test)) ) {
+        return false;
+    }
+    for( size_t i = 0; i < x.n_body; i++ ) {
+        ASR::case_stmt_t* case_body = x.m_body[i];
+        switch( case_body->type ) {
+            case ASR::case_stmtType::CaseStmt: {
+                ASR::CaseStmt_t* Case_Stmt = down_cast<ASR::CaseStmt_t>(case_body);
+                for( size_t j = 0; j < Case_Stmt->n_test; j++ ) {
+                    int64_t n;
+                    if( !is_constant(Case_Stmt->m_test[j], n) ) {
+                        return false;
+                    }
+                    ranges.push_back({n, n, i});
+                }
+                break;
+            }
+            case ASR::case_stmtType::CaseStmt_Range: {
+                ASR::CaseStmt_Range_t* Case_Stmt = down_cast<ASR::CaseStmt_Range_t>(case_body);
+                CaseRange range = {std::numeric_limits<int64_t>::min(),
+                                   std::numeric_limits<int64_t>::max(), i};
+                if( (Case_Stmt->m_start && !is_constant(Case_Stmt->m_start, range.lo)) ||
+                    (Case_Stmt->m_end && !is_constant(Case_Stmt->m_end, range.hi)) ) {
+                    return false;
+                }
+                if( range.lo <= range.hi ) {
+                    ranges.push_back(range);
+                }
+                break;
+            }
+        }
+    }
+    std::sort(ranges.begin(), ranges.end(),
+        [](const CaseRange &a, const CaseRange &b) { return a.lo < b.lo; });
+    for( size_t i = 1; i < ranges.size(); i++ ) {
+        if( ranges[i].lo <= ranges[i - 1].hi ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns true if the sorted `ranges` are dense enough for a jump table
+static bool is_dense(const std::vector<CaseRange> &ranges) {
+    int64_t n_values = 0;
+    for( auto &range: ranges ) {
+        if( range.lo == std::numeric_limits<int64_t>::min() ||
+            range.hi == std::numeric_limits<int64_t>::max() ||
+            (uint64_t) range.hi - (uint64_t) range.lo >= (uint64_t) max_switch_values ) {
+            return false;
+        }
+        n_values += range.hi - range.lo + 1;
+    }
+    if( n_values > max_switch_values ) {
+        return false;
+    }
+    uint64_t span = (uint64_t) ranges.back().hi - (uint64_t) ranges.front().lo + 1;
+    return span <= (uint64_t) (max_switch_span_per_value * n_values);
+}
+
+// Finds an `Exit` of the loop that encloses the visited statements
+class LoopExitVisitor : public ASR::BaseWalkVisitor<LoopExitVisitor>
+{
+public:
+    bool has_exit;
+    size_t loop_depth;
+
+    LoopExitVisitor() : has_exit{false}, loop_depth{0} {}
+
+    void visit_Exit(const ASR::Exit_t &/*x*/) {
+        if( loop_depth == 0 ) {
+            has_exit = true;
+        }
+    }
+
+    void visit_WhileLoop(const ASR::WhileLoop_t &x) {
+        loop_depth++;
+        ASR::BaseWalkVisitor<LoopExitVisitor>::visit_WhileLoop(x);
+        loop_depth--;
+    }
+
+    void visit_DoLoop(const ASR::DoLoop_t &x) {
+        loop_depth++;
+        ASR::BaseWalkVisitor<LoopExitVisitor>::visit_DoLoop(x);
+        loop_depth--;
+    }
+
+    void visit_DoConcurrentLoop(const ASR::DoConcurrentLoop_t &x) {
+        loop_depth++;
+        ASR::BaseWalkVisitor<LoopExitVisitor>::visit_DoConcurrentLoop(x);
+        loop_depth--;
+    }
+};
+
+static bool has_loop_exit(const ASR::Select_t &x) {
+    LoopExitVisitor v;
+    for( size_t i = 0; i < x.n_body; i++ ) {
+        v.visit_case_stmt(*x.m_body[i]);
+    }
+    for( size_t i = 0; i < x.n_default; i++ ) {
+        v.visit_stmt(*x.m_default[i]);
+    }
+    return v.has_exit;
+}
+
+// Returns the integer variable that `test` compares with constants
+// (`a == 1` or `a == 1 or a == 2`) and appends the constants to `values`,
+// nullptr if `test` is not such a comparison
+static ASR::symbol_t* get_compared_var(ASR::expr_t* test, std::vector<ASR::expr_t*> &values) {
+    if( is_a<ASR::LogicalBinOp_t>(*test) ) {
+        ASR::LogicalBinOp_t* binop = down_cast<ASR::LogicalBinOp_t>(test);
+        if( binop->m_op != ASR::logicalbinopType::Or ) {
+            return nullptr;
+        }
+        ASR::symbol_t* left = get_compared_var(binop->m_left, values);
+        ASR::symbol_t* right = get_compared_var(binop->m_right, values);
+        return left == right ? left : nullptr;
+    }
+    if( !is_a<ASR::IntegerCompare_t>(*test) ) {
+        return nullptr;
+    }
+    ASR::IntegerCompare_t* compare = down_cast<ASR::IntegerCompare_t>(test);
+    if( compare->m_op != ASR::cmpopType::Eq ) {
+        return nullptr;
+    }
+    ASR::expr_t* var = compare->m_left;
+    ASR::expr_t* value = compare->m_right;
+    int64_t n;
+    if( !is_constant(value, n) ) {
+        std::swap(var, value);
+    }
+    if( !is_a<ASR::Var_t>(*var) || !is_constant(value, n) ) {
+        return nullptr;
+    }
+    values.push_back(value);
+    return down_cast<ASR::Var_t>(var)->m_v;
 }
 
 class SelectCaseVisitor : public PassUtils::PassVisitor<SelectCaseVisitor>
 {
+private:
+
+    bool native_switch;
 
 public:
-    SelectCaseVisitor(Allocator &al) : PassVisitor(al, nullptr) {
+    SelectCaseVisitor(Allocator &al, bool native_switch) : PassVisitor(al, nullptr),
+        native_switch{native_switch} {
     }
 
     void visit_WhileLoop(const ASR::WhileLoop_t &x) {
@@ -160,19 +364,292 @@ public:
         transform_stmts(xx.m_body, xx.n_body);
     }
 
+    void visit_If(const ASR::If_t &x) {
+        ASR::Select_t* select = if_to_select(x);
+        if( select ) {
+            visit_Select(*select);
+            if( pass_result.size() == 0 ) {
+                pass_result.push_back(al, &select->base);
+            }
+            return;
+        }
+        ASR::If_t &xx = const_cast<ASR::If_t&>(x);
+        transform_stmts(xx.m_body, xx.n_body);
+        transform_stmts(xx.m_orelse, xx.n_orelse);
+    }
+
     void visit_Select(const ASR::Select_t &x) {
-        pass_result = replace_selectcase(al, x);
+        ASR::Select_t &xx = const_cast<ASR::Select_t&>(x);
+        for( size_t i = 0; i < x.n_body; i++ ) {
+            ASR::case_stmt_t* case_body = x.m_body[i];
+            switch( case_body->type ) {
+                case ASR::case_stmtType::CaseStmt: {
+                    ASR::CaseStmt_t* Case_Stmt = down_cast<ASR::CaseStmt_t>(case_body);
+                    transform_stmts(Case_Stmt->m_body, Case_Stmt->n_body);
+                    break;
+                }
+                case ASR::case_stmtType::CaseStmt_Range: {
+                    ASR::CaseStmt_Range_t* Case_Stmt = down_cast<ASR::CaseStmt_Range_t>(case_body);
+                    transform_stmts(Case_Stmt->m_body, Case_Stmt->n_body);
+                    break;
+                }
+            }
+        }
+        transform_stmts(xx.m_default, xx.n_default);
+
+        Vec<ASR::stmt_t*> body;
+        body.reserve(al, 2);
+        lower_select(xx, body);
+        pass_result = body;
+    }
+
+    // Turns the chain `if a == c1: ... elif a == c2: ... else: ...` on an
+    // integer variable with distinct constants into a select, the first `if`
+    // that does not compare `a` with new constants starts the default.
+    // Returns nullptr if the chain is too short.
+    ASR::Select_t* if_to_select(const ASR::If_t &x) {
+        const Location &loc = x.base.base.loc;
+        ASR::symbol_t* var = nullptr;
+        std::set<int64_t> seen;
+        Vec<ASR::case_stmt_t*> cases;
+        cases.reserve(al, min_dispatch_cases);
+        Vec<ASR::stmt_t*> default_body;
+        default_body.reserve(al, 1);
+        ASR::If_t* arm = const_cast<ASR::If_t*>(&x);
+        while( true ) {
+            std::vector<ASR::expr_t*> values;
+            ASR::symbol_t* arm_var = get_compared_var(arm->m_test, values);
+            std::set<int64_t> arm_seen;
+            bool is_case = arm_var && (var == nullptr || arm_var == var);
+            for( size_t i = 0; i < values.size() && is_case; i++ ) {
+                int64_t n;
+                is_constant(values[i], n);
+                is_case = seen.find(n) == seen.end() && arm_seen.insert(n).second;
+            }
+            if( !is_case ) {
+                default_body.push_back(al, &arm->base);
+                break;
+            }
+            var = arm_var;
+            seen.insert(arm_seen.begin(), arm_seen.end());
+            Vec<ASR::expr_t*> tests;
+            tests.reserve(al, values.size());
+            for( auto value: values ) {
+                tests.push_back(al, value);
+            }
+            cases.push_back(al, down_cast<ASR::case_stmt_t>(ASR::make_CaseStmt_t(al,
+                arm->base.base.loc, tests.p, tests.size(), arm->m_body, arm->n_body)));
+            if( arm->n_orelse == 1 && is_a<ASR::If_t>(*arm->m_orelse[0]) ) {
+                arm = down_cast<ASR::If_t>(arm->m_orelse[0]);
+            } else {
+                for( size_t i = 0; i < arm->n_orelse; i++ ) {
+                    default_body.push_back(al, arm->m_orelse[i]);
+                }
+                break;
+            }
+        }
+        if( cases.size() < min_dispatch_cases ) {
+            return nullptr;
+        }
+        ASR::expr_t* test = ASRUtils::EXPR(ASR::make_Var_t(al, loc, var));
+        return ASR::down_cast2<ASR::Select_t>(ASR::make_Select_t(al, loc, test,
+            cases.p, cases.size(), default_body.p, default_body.size()));
+    }
+
+    ASR::expr_t* make_var(const Location &loc, ASR::symbol_t* sym) {
+        return ASRUtils::EXPR(ASR::make_Var_t(al, loc, sym));
+    }
+
+    ASR::expr_t* make_int(const Location &loc, int64_t n, ASR::ttype_t* type) {
+        return ASRUtils::EXPR(ASR::make_IntegerConstant_t(al, loc, n, type));
+    }
+
+    ASR::expr_t* make_compare(const Location &loc, ASR::expr_t* left,
+                              ASR::cmpopType op, ASR::expr_t* right) {
+        ASR::ttype_t* logical_type = ASRUtils::TYPE(ASR::make_Logical_t(al, loc, 4, nullptr, 0));
+        return ASRUtils::EXPR(ASR::make_IntegerCompare_t(al, loc, left, op, right,
+            logical_type, nullptr));
+    }
+
+    ASR::expr_t* make_range_test(const Location &loc, ASR::symbol_t* a, const CaseRange &range) {
+        ASR::ttype_t* type = ASRUtils::symbol_type(a);
+        ASR::ttype_t* logical_type = ASRUtils::TYPE(ASR::make_Logical_t(al, loc, 4, nullptr, 0));
+        if( range.lo == range.hi ) {
+            return make_compare(loc, make_var(loc, a), ASR::cmpopType::Eq,
+                make_int(loc, range.lo, type));
+        }
+        ASR::expr_t* test = nullptr;
+        if( range.lo != std::numeric_limits<int64_t>::min() ) {
+            test = make_compare(loc, make_int(loc, range.lo, type),
+                ASR::cmpopType::LtE, make_var(loc, a));
+        }
+        if( range.hi != std::numeric_limits<int64_t>::max() ) {
+            ASR::expr_t* upper = make_compare(loc, make_var(loc, a),
+                ASR::cmpopType::LtE, make_int(loc, range.hi, type));
+            test = test ? ASRUtils::EXPR(ASR::make_LogicalBinOp_t(al, loc, test,
+                ASR::logicalbinopType::And, upper, logical_type, nullptr)) : upper;
+        }
+        if( test == nullptr ) {
+            test = ASRUtils::EXPR(ASR::make_LogicalConstant_t(al, loc, true, logical_type));
+        }
+        return test;
+    }
+
+    // Appends the binary search of `a` over the sorted `ranges[l:r]` to
+    // `body`, the case `idx` runs `bodies[idx]`. Nothing runs if `a` is in
+    // none of the ranges.
+    void binary_search(const Location &loc, ASR::symbol_t* a,
+            const std::vector<CaseRange> &ranges, size_t l, size_t r,
+            const std::vector<Vec<ASR::stmt_t*>> &bodies, Vec<ASR::stmt_t*> &body) {
+        if( r - l <= max_leaf_cases ) {
+            ASR::stmt_t* chain = nullptr;
+            for( size_t i = r; i-- > l; ) {
+                Vec<ASR::stmt_t*> orelse;
+                orelse.reserve(al, 1);
+                if( chain ) {
+                    orelse.push_back(al, chain);
+                }
+                const Vec<ASR::stmt_t*> &case_body = bodies[ranges[i].idx];
+                chain = ASRUtils::STMT(ASR::make_If_t(al, loc, make_range_test(loc, a, ranges[i]),
+                    case_body.p, case_body.size(), orelse.p, orelse.size()));
+            }
+            body.push_back(al, chain);
+            return;
+        }
+        size_t mid = l + (r - l) / 2;
+        Vec<ASR::stmt_t*> lower, upper;
+        lower.reserve(al, 1);
+        upper.reserve(al, 1);
+        binary_search(loc, a, ranges, l, mid, bodies, lower);
+        binary_search(loc, a, ranges, mid, r, bodies, upper);
+        ASR::expr_t* test = make_compare(loc, make_var(loc, a), ASR::cmpopType::Lt,
+            make_int(loc, ranges[mid].lo, ASRUtils::symbol_type(a)));
+        body.push_back(al, ASRUtils::STMT(ASR::make_If_t(al, loc, test,
+            lower.p, lower.size(), upper.p, upper.size())));
+    }
+
+    ASR::symbol_t* create_variable(const Location &loc, const std::string &name,
+                                   ASR::ttype_t* type) {
+        std::string unique_name = current_scope->get_unique_name(name);
+        Location var_loc = loc;
+        ASR::expr_t* var = PassUtils::create_auxiliary_variable(var_loc, unique_name,
+            al, current_scope, type);
+        return down_cast<ASR::Var_t>(var)->m_v;
+    }
+
+    // Appends the statements that implement the select `x` to `body`
+    void lower_select(ASR::Select_t &x, Vec<ASR::stmt_t*> &body) {
+        const Location &loc = x.base.base.loc;
+        std::vector<CaseRange> ranges;
+        if( x.n_body == 0 ) {
+            for( size_t i = 0; i < x.n_default; i++ ) {
+                body.push_back(al, x.m_default[i]);
+            }
+            return;
+        }
+        if( !get_case_ranges(x, ranges) || ranges.size() < min_dispatch_cases ) {
+            Vec<ASR::stmt_t*> if_chain;
+            case_to_if(al, x, x.m_test, if_chain);
+            body.push_back(al, if_chain[0]);
+            return;
+        }
+
+        // The test is evaluated once
+        ASR::symbol_t* a = nullptr;
+        if( is_a<ASR::Var_t>(*x.m_test) ) {
+            a = down_cast<ASR::Var_t>(x.m_test)->m_v;
+        } else {
+            a = create_variable(loc, "_lcompilers_select_test",
+                ASRUtils::expr_type(x.m_test));
+            body.push_back(al, ASRUtils::STMT(ASR::make_Assignment_t(al, loc,
+                make_var(loc, a), x.m_test, nullptr)));
+            x.m_test = make_var(loc, a);
+        }
+
+        if( native_switch && is_dense(ranges) && !has_loop_exit(x) ) {
+            body.push_back(al, &x.base);
+            return;
+        }
+
+        std::vector<size_t> n_ranges(x.n_body, 0);
+        for( auto &range: ranges ) {
+            n_ranges[range.idx]++;
+        }
+        bool direct = x.n_default == 0 && std::all_of(n_ranges.begin(),
+            n_ranges.end(), [](size_t n) { return n <= 1; });
+        std::vector<Vec<ASR::stmt_t*>> bodies(x.n_body);
+        if( direct ) {
+            for( size_t i = 0; i < x.n_body; i++ ) {
+                get_case_body(x.m_body[i], bodies[i]);
+            }
+            binary_search(loc, a, ranges, 0, ranges.size(), bodies, body);
+            return;
+        }
+
+        // The search stores the index of the case in `k` (`x.n_body` for the
+        // default), then a select on `k` runs the body
+        ASR::ttype_t* int_type = ASRUtils::TYPE(ASR::make_Integer_t(al, loc, 4, nullptr, 0));
+        ASR::symbol_t* k = create_variable(loc, "_lcompilers_select_case", int_type);
+        body.push_back(al, ASRUtils::STMT(ASR::make_Assignment_t(al, loc,
+            make_var(loc, k), make_int(loc, x.n_body, int_type), nullptr)));
+        for( size_t i = 0; i < x.n_body; i++ ) {
+            bodies[i].reserve(al, 1);
+            bodies[i].push_back(al, ASRUtils::STMT(ASR::make_Assignment_t(al, loc,
+                make_var(loc, k), make_int(loc, i, int_type), nullptr)));
+        }
+        binary_search(loc, a, ranges, 0, ranges.size(), bodies, body);
+
+        Vec<ASR::case_stmt_t*> cases;
+        cases.reserve(al, x.n_body + 1);
+        for( size_t i = 0; i <= x.n_body; i++ ) {
+            Vec<ASR::stmt_t*> case_body;
+            if( i < x.n_body ) {
+                get_case_body(x.m_body[i], case_body);
+            } else if( x.n_default > 0 ) {
+                case_body.from_pointer_n(x.m_default, x.n_default);
+            } else {
+                break;
+            }
+            Vec<ASR::expr_t*> tests;
+            tests.reserve(al, 1);
+            tests.push_back(al, make_int(loc, i, int_type));
+            cases.push_back(al, down_cast<ASR::case_stmt_t>(ASR::make_CaseStmt_t(al,
+                loc, tests.p, tests.size(), case_body.p, case_body.size())));
+        }
+        ASR::Select_t* select_k = ASR::down_cast2<ASR::Select_t>(ASR::make_Select_t(al, loc,
+            make_var(loc, k), cases.p, cases.size(), nullptr, 0));
+        lower_select(*select_k, body);
+    }
+
+    static void get_case_body(ASR::case_stmt_t* case_body, Vec<ASR::stmt_t*> &body) {
+        switch( case_body->type ) {
+            case ASR::case_stmtType::CaseStmt: {
+                ASR::CaseStmt_t* Case_Stmt = down_cast<ASR::CaseStmt_t>(case_body);
+                body.from_pointer_n(Case_Stmt->m_body, Case_Stmt->n_body);
+                break;
+            }
+            case ASR::case_stmtType::CaseStmt_Range: {
+                ASR::CaseStmt_Range_t* Case_Stmt = down_cast<ASR::CaseStmt_Range_t>(case_body);
+                body.from_pointer_n(Case_Stmt->m_body, Case_Stmt->n_body);
+                break;
+            }
+        }
     }
 };
 
 void pass_replace_select_case(Allocator &al, ASR::TranslationUnit_t &unit,
-                              const LCompilers::PassOptions& /*pass_options*/) {
-    SelectCaseVisitor v(al);
-    // Each call transforms only one layer of nested loops, so we call it twice
-    // to transform doubly nested loops:
-    v.visit_TranslationUnit(unit);
+                              const LCompilers::PassOptions& pass_options) {
+    // The bodies of the loops, `if`s and cases are transformed as they are
+    // visited, so one call transforms the nested selects as well
+    SelectCaseVisitor v(al, pass_options.native_switch);
     v.visit_TranslationUnit(unit);
 }
 
+void pass_replace_select_case_symbol(Allocator &al, ASR::TranslationUnit_t &/*unit*/,
+                                     ASR::symbol_t &sym, const LCompilers::PassOptions& pass_options) {
+    SelectCaseVisitor v(al, pass_options.native_switch);
+    v.visit_symbol(sym);
+}
+
 
 } // namespace LFortran
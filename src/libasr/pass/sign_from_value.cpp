@@ -158,5 +158,11 @@ void pass_replace_sign_from_value(Allocator &al, ASR::TranslationUnit_t &unit,
     v.visit_TranslationUnit(unit);
 }
 
+void pass_replace_sign_from_value_symbol(Allocator &al, ASR::TranslationUnit_t &unit,
+                                         ASR::symbol_t &sym, const LCompilers::PassOptions& pass_options) {
+    SignFromValueVisitor v(al, unit, pass_options);
+    v.visit_symbol(sym);
+}
+
 
 } // namespace LFortran
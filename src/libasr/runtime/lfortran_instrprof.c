@@ -0,0 +1,133 @@
+/*
+Minimal runtime for the LLVM profile instrumentation (`--profile-generate`).
+
+The instrumented code increments counters in the `__llvm_prf_cnts` section and
+describes every function in `__llvm_prf_data` and `__llvm_prf_names`. At exit
+the three sections are written to a raw profile (version 8, the format of
+LLVM 14) that `llvm-profdata merge` turns into the `.profdata` file for
+`--profile-use`.
+
+The file name is taken from the `LLVM_PROFILE_FILE` environment variable
+(`%p` is replaced by the process id), `default.profraw` otherwise. Value
+profiling is not supported, the compiler disables it.
+
+This must be linked statically into the executable: the section bounds
+`__start_*`/`__stop_*` are those of the module the code is linked into.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#define INSTRPROF_RAW_MAGIC_64 ((uint64_t)255 << 56 | (uint64_t)'l' << 48 | \
+    (uint64_t)'p' << 40 | (uint64_t)'r' << 32 | (uint64_t)'o' << 24 | \
+    (uint64_t)'f' << 16 | (uint64_t)'r' << 8 | (uint64_t)129)
+#define INSTRPROF_RAW_VERSION 8
+// The last value profiling kind (IPVK_MemOPSize)
+#define INSTRPROF_VALUE_KIND_LAST 1
+
+#define WEAK_HIDDEN __attribute__((weak, visibility("hidden")))
+
+extern char __start___llvm_prf_data[] WEAK_HIDDEN;
+extern char __stop___llvm_prf_data[] WEAK_HIDDEN;
+extern char __start___llvm_prf_cnts[] WEAK_HIDDEN;
+extern char __stop___llvm_prf_cnts[] WEAK_HIDDEN;
+extern char __start___llvm_prf_names[] WEAK_HIDDEN;
+extern char __stop___llvm_prf_names[] WEAK_HIDDEN;
+
+// Emitted by the instrumentation: the version with the variant flags (IR
+// level profile etc.)
+extern uint64_t __llvm_profile_raw_version WEAK_HIDDEN;
+
+// The executable is linked with `-u __llvm_profile_runtime` so that this
+// object file (and its constructor) is always included
+int __llvm_profile_runtime;
+
+struct instrprof_header {
+    uint64_t magic;
+    uint64_t version;
+    uint64_t binary_ids_size;
+    uint64_t data_size;
+    uint64_t padding_bytes_before_counters;
+    uint64_t counters_size;
+    uint64_t padding_bytes_after_counters;
+    uint64_t names_size;
+    uint64_t counters_delta;
+    uint64_t names_delta;
+    uint64_t value_kind_last;
+};
+
+// The size of one `__llvm_prf_data` record: NameRef, FuncHash, CounterPtr,
+// FunctionPointer, Values, NumCounters and NumValueSites[2]
+#define INSTRPROF_DATA_RECORD_SIZE (5*8 + 4 + 2*2)
+
+static void instrprof_filename(char *buf, size_t size)
+{
+    const char *pattern = getenv("LLVM_PROFILE_FILE");
+    size_t n = 0;
+    if (pattern == NULL || pattern[0] == '\0') {
+        pattern = "default.profraw";
+    }
+    for (; *pattern != '\0' && n + 1 < size; pattern++) {
+        if (pattern[0] == '%' && pattern[1] == 'p') {
+            n += snprintf(buf + n, size - n, "%d", (int)getpid());
+            if (n >= size) n = size - 1;
+            pattern++;
+        } else {
+            buf[n++] = *pattern;
+        }
+    }
+    buf[n] = '\0';
+}
+
+static void instrprof_write(void)
+{
+    char filename[4096];
+    FILE *f;
+    struct instrprof_header header;
+    uint64_t data_bytes = __stop___llvm_prf_data - __start___llvm_prf_data;
+    uint64_t counters_bytes = __stop___llvm_prf_cnts - __start___llvm_prf_cnts;
+    uint64_t names_bytes = __stop___llvm_prf_names - __start___llvm_prf_names;
+    uint64_t names_padding = (8 - names_bytes % 8) % 8;
+    static const char zeros[8] = {0};
+
+    if (__start___llvm_prf_data == NULL || data_bytes == 0) {
+        // Nothing is instrumented
+        return;
+    }
+    header.magic = INSTRPROF_RAW_MAGIC_64;
+    header.version = &__llvm_profile_raw_version != NULL
+        ? __llvm_profile_raw_version : INSTRPROF_RAW_VERSION;
+    header.binary_ids_size = 0;
+    header.data_size = data_bytes / INSTRPROF_DATA_RECORD_SIZE;
+    header.padding_bytes_before_counters = 0;
+    header.counters_size = counters_bytes / sizeof(uint64_t);
+    header.padding_bytes_after_counters = 0;
+    header.names_size = names_bytes;
+    header.counters_delta = (uint64_t)(uintptr_t)__start___llvm_prf_cnts
+        - (uint64_t)(uintptr_t)__start___llvm_prf_data;
+    header.names_delta = (uint64_t)(uintptr_t)__start___llvm_prf_names;
+    header.value_kind_last = INSTRPROF_VALUE_KIND_LAST;
+
+    instrprof_filename(filename, sizeof(filename));
+    f = fopen(filename, "wb");
+    if (f == NULL) {
+        fprintf(stderr, "Profile: cannot open '%s' for writing\n", filename);
+        return;
+    }
+    if (fwrite(&header, sizeof(header), 1, f) != 1
+            || fwrite(__start___llvm_prf_data, 1, data_bytes, f) != data_bytes
+            || fwrite(__start___llvm_prf_cnts, 1, counters_bytes, f) != counters_bytes
+            || fwrite(__start___llvm_prf_names, 1, names_bytes, f) != names_bytes
+            || fwrite(zeros, 1, names_padding, f) != names_padding) {
+        fprintf(stderr, "Profile: cannot write '%s'\n", filename);
+    }
+    fclose(f);
+}
+
+__attribute__((constructor)) static void instrprof_initialize(void)
+{
+    atexit(instrprof_write);
+}
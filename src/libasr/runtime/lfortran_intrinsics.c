@@ -11,6 +11,10 @@
 
 #include "lfortran_intrinsics.h"
 
+#ifdef HAVE_LFORTRAN_CBLAS
+#include <cblas.h>
+#endif
+
 
 LFORTRAN_API double _lfortran_sum(int n, double *v)
 {
@@ -600,6 +604,581 @@ LFORTRAN_API double_complex_t _lfortran_zatanh(double_complex_t x)
     return catanh(x);
 }
 
+// Vectorized kernels ----------------------------------------------------------
+
+// The kernels below apply a math function to a whole (contiguous) array. The
+// main loops have no branches and no calls into libm, so that the compiler
+// vectorizes them. On x86-64 Linux a clone of each kernel is compiled for
+// AVX-512, AVX2 and the baseline instruction set and the right one is
+// selected for the CPU when the program is loaded.
+#if defined(__x86_64__) && defined(__linux__) && \
+    ((defined(__clang__) && __clang_major__ >= 14) || \
+     (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 6))
+#define LFORTRAN_SIMD_KERNEL __attribute__((target_clones("arch=skylake-avx512", "arch=haswell", "default")))
+#else
+#define LFORTRAN_SIMD_KERNEL
+#endif
+
+static inline uint64_t _lfortran_simd_asuint64(double x)
+{
+    uint64_t i;
+    memcpy(&i, &x, sizeof(i));
+    return i;
+}
+
+static inline double _lfortran_simd_asdouble(uint64_t i)
+{
+    double x;
+    memcpy(&x, &i, sizeof(x));
+    return x;
+}
+
+// Adding and subtracting this constant rounds to the nearest integer, which
+// is then also available in the low bits of the sum
+#define LFORTRAN_SIMD_ROUND_SHIFT 6755399441055744.0 // 1.5*2^52
+#define LFORTRAN_SIMD_LN2_HI 6.93147180369123816490e-01
+#define LFORTRAN_SIMD_LN2_LO 1.90821492927058770002e-10
+
+// Returns 1 if all the values are finite and their magnitude is at most
+// `max_abs`, which is the range where the argument reduction is accurate
+static inline int _lfortran_simd_in_range(int64_t n, const double *x,
+    double max_abs)
+{
+    int64_t i;
+    int out_of_range = 0;
+    for (i = 0; i < n; i++) {
+        out_of_range |= !(fabs(x[i]) <= max_abs);
+    }
+    return !out_of_range;
+}
+
+static inline int _lfortran_simd_in_range_f32(int64_t n, const float *x,
+    float max_abs)
+{
+    int64_t i;
+    int out_of_range = 0;
+    for (i = 0; i < n; i++) {
+        out_of_range |= !(fabsf(x[i]) <= max_abs);
+    }
+    return !out_of_range;
+}
+
+static inline double _lfortran_simd_exp(double x)
+{
+    // exp(x) = 2^k exp(r), with k = round(x/log(2)) and |r| <= log(2)/2
+    double xc = x < -746.0 ? -746.0 : (x > 710.0 ? 710.0 : x);
+    double kd = xc * 1.44269504088896338700e+00 + LFORTRAN_SIMD_ROUND_SHIFT;
+    int64_t k = (int64_t)(_lfortran_simd_asuint64(kd)
+        - _lfortran_simd_asuint64(LFORTRAN_SIMD_ROUND_SHIFT));
+    kd -= LFORTRAN_SIMD_ROUND_SHIFT;
+    double r = (xc - kd * LFORTRAN_SIMD_LN2_HI) - kd * LFORTRAN_SIMD_LN2_LO;
+    // Taylor polynomial of degree 13, accurate to below 1 ulp on |r| <= 0.35
+    double p = 1.0 / 6227020800.0;
+    p = p * r + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+    // 2^k is applied in two steps, so that the exponents stay representable
+    // for results that overflow or are subnormal
+    int64_t k1 = k / 2;
+    int64_t k2 = k - k1;
+    double s1 = _lfortran_simd_asdouble((uint64_t)(k1 + 1023) << 52);
+    double s2 = _lfortran_simd_asdouble((uint64_t)(k2 + 1023) << 52);
+    double y = p * s1 * s2;
+    return x != x ? x : y;
+}
+
+static inline double _lfortran_simd_expm1(double x)
+{
+    // exp(x) - 1 loses precision for small x, use the Taylor series there
+    double p = 1.0 / 355687428096000.0;
+    p = p * x + 1.0 / 20922789888000.0;
+    p = p * x + 1.0 / 1307674368000.0;
+    p = p * x + 1.0 / 87178291200.0;
+    p = p * x + 1.0 / 6227020800.0;
+    p = p * x + 1.0 / 479001600.0;
+    p = p * x + 1.0 / 39916800.0;
+    p = p * x + 1.0 / 3628800.0;
+    p = p * x + 1.0 / 362880.0;
+    p = p * x + 1.0 / 40320.0;
+    p = p * x + 1.0 / 5040.0;
+    p = p * x + 1.0 / 720.0;
+    p = p * x + 1.0 / 120.0;
+    p = p * x + 1.0 / 24.0;
+    p = p * x + 1.0 / 6.0;
+    p = p * x + 0.5;
+    p = p * x * x + x;
+    double y = _lfortran_simd_exp(x) - 1.0;
+    return fabs(x) < 0.5 ? p : y;
+}
+
+static inline double _lfortran_simd_log(double x)
+{
+    // Subnormal numbers are scaled by 2^54 into the normal range first
+    int subnormal = x < DBL_MIN;
+    double xs = subnormal ? x * 18014398509481984.0 : x;
+    uint64_t ix = _lfortran_simd_asuint64(xs);
+    // The biased exponent is converted to a double exactly via its bits
+    double e = _lfortran_simd_asdouble(((ix >> 52) & 0x7ff)
+        | 0x4330000000000000ULL) - (4503599627370496.0 + 1023.0);
+    e = subnormal ? e - 54.0 : e;
+    // x = 2^e m, with m in [sqrt(2)/2, sqrt(2))
+    double m = _lfortran_simd_asdouble((ix & 0x000fffffffffffffULL)
+        | 0x3ff0000000000000ULL);
+    int big = m > 1.41421356237309504880;
+    m = big ? 0.5 * m : m;
+    e = big ? e + 1.0 : e;
+    // log(1+f) = 2 atanh(s) = f - s*(f - 2*(z/3 + z^2/5 + ...)),
+    // with s = f/(2+f), z = s^2 and |s| <= 0.172
+    double f = m - 1.0;
+    double s = f / (2.0 + f);
+    double z = s * s;
+    double t = 1.0 / 23.0;
+    t = t * z + 1.0 / 21.0;
+    t = t * z + 1.0 / 19.0;
+    t = t * z + 1.0 / 17.0;
+    t = t * z + 1.0 / 15.0;
+    t = t * z + 1.0 / 13.0;
+    t = t * z + 1.0 / 11.0;
+    t = t * z + 1.0 / 9.0;
+    t = t * z + 1.0 / 7.0;
+    t = t * z + 1.0 / 5.0;
+    t = t * z + 1.0 / 3.0;
+    t = t * z;
+    double y = e * LFORTRAN_SIMD_LN2_HI
+        + ((f - s * (f - 2.0 * t)) + e * LFORTRAN_SIMD_LN2_LO);
+    y = x == 0.0 ? -INFINITY : y;
+    y = x < 0.0 ? NAN : y;
+    y = x == INFINITY ? x : y;
+    return x != x ? x : y;
+}
+
+// Reduces x to r in [-pi/4, pi/4] with x = n pi/2 + r (accurate for
+// |x| <= 1e5) and returns sin(r) and cos(r) together with n
+static inline void _lfortran_simd_sincos_reduced(double x, double *sin_r,
+    double *cos_r, int64_t *n)
+{
+    double nd = x * 6.36619772367581382433e-01 + LFORTRAN_SIMD_ROUND_SHIFT;
+    *n = (int64_t)(_lfortran_simd_asuint64(nd)
+        - _lfortran_simd_asuint64(LFORTRAN_SIMD_ROUND_SHIFT));
+    nd -= LFORTRAN_SIMD_ROUND_SHIFT;
+    // pi/2 split into parts with 33 significant bits each (from fdlibm)
+    double r = x - nd * 1.57079632673412561417e+00;
+    r = r - nd * 6.07710050630396597660e-11;
+    r = r - nd * 2.02226624879595063154e-21;
+    // Minimax polynomials on [-pi/4, pi/4] (from fdlibm)
+    double z = r * r;
+    double s = 1.58969099521155010221e-10;
+    s = s * z - 2.50507602534068634195e-08;
+    s = s * z + 2.75573137070700676789e-06;
+    s = s * z - 1.98412698298579493134e-04;
+    s = s * z + 8.33333333332248946124e-03;
+    s = s * z - 1.66666666666666324348e-01;
+    *sin_r = r + r * z * s;
+    double c = -1.13596475577881948265e-11;
+    c = c * z + 2.08757232129817482790e-09;
+    c = c * z - 2.75573143513906633035e-07;
+    c = c * z + 2.48015872894767294178e-05;
+    c = c * z - 1.38888888888741095749e-03;
+    c = c * z + 4.16666666666666019037e-02;
+    *cos_r = 1.0 - 0.5 * z + z * z * c;
+}
+
+static inline double _lfortran_simd_sin(double x)
+{
+    double s, c;
+    int64_t n;
+    _lfortran_simd_sincos_reduced(x, &s, &c, &n);
+    double y = (n & 1) ? c : s;
+    return (n & 2) ? -y : y;
+}
+
+static inline double _lfortran_simd_cos(double x)
+{
+    double s, c;
+    int64_t n;
+    _lfortran_simd_sincos_reduced(x, &s, &c, &n);
+    double y = (n & 1) ? s : c;
+    return ((n + 1) & 2) ? -y : y;
+}
+
+static inline double _lfortran_simd_tan(double x)
+{
+    double s, c;
+    int64_t n;
+    _lfortran_simd_sincos_reduced(x, &s, &c, &n);
+    return (n & 1) ? -c / s : s / c;
+}
+
+static inline double _lfortran_simd_tanh(double x)
+{
+    // tanh(|x|) = expm1(2|x|) / (expm1(2|x|) + 2), which is 1 for |x| > 22
+    double ax = fabs(x);
+    ax = ax > 22.0 ? 22.0 : ax;
+    double e = _lfortran_simd_expm1(2.0 * ax);
+    double y = copysign(e / (e + 2.0), x);
+    return x != x ? x : y;
+}
+
+#define LFORTRAN_SIMD_MAX_REDUCED 1e5
+
+LFORTRAN_API LFORTRAN_SIMD_KERNEL void _lfortran_vdexp(int64_t n, void *x, void *y)
+{
+    const double *a = (const double *)x;
+    double *b = (double *)y;
+    int64_t i;
+    for (i = 0; i < n; i++) {
+        b[i] = _lfortran_simd_exp(a[i]);
+    }
+}
+
+LFORTRAN_API LFORTRAN_SIMD_KERNEL void _lfortran_vsexp(int64_t n, void *x, void *y)
+{
+    const float *a = (const float *)x;
+    float *b = (float *)y;
+    int64_t i;
+    for (i = 0; i < n; i++) {
+        b[i] = (float)_lfortran_simd_exp(a[i]);
+    }
+}
+
+LFORTRAN_API LFORTRAN_SIMD_KERNEL void _lfortran_vdlog(int64_t n, void *x, void *y)
+{
+    const double *a = (const double *)x;
+    double *b = (double *)y;
+    int64_t i;
+    for (i = 0; i < n; i++) {
+        b[i] = _lfortran_simd_log(a[i]);
+    }
+}
+
+LFORTRAN_API LFORTRAN_SIMD_KERNEL void _lfortran_vslog(int64_t n, void *x, void *y)
+{
+    const float *a = (const float *)x;
+    float *b = (float *)y;
+    int64_t i;
+    for (i = 0; i < n; i++) {
+        b[i] = (float)_lfortran_simd_log(a[i]);
+    }
+}
+
+LFORTRAN_API LFORTRAN_SIMD_KERNEL void _lfortran_vdtanh(int64_t n, void *x, void *y)
+{
+    const double *a = (const double *)x;
+    double *b = (double *)y;
+    int64_t i;
+    for (i = 0; i < n; i++) {
+        b[i] = _lfortran_simd_tanh(a[i]);
+    }
+}
+
+LFORTRAN_API LFORTRAN_SIMD_KERNEL void _lfortran_vstanh(int64_t n, void *x, void *y)
+{
+    const float *a = (const float *)x;
+    float *b = (float *)y;
+    int64_t i;
+    for (i = 0; i < n; i++) {
+        b[i] = (float)_lfortran_simd_tanh(a[i]);
+    }
+}
+
+// The trigonometric kernels fall back to libm if any argument is outside of
+// the range where the argument reduction is accurate
+#define LFORTRAN_SIMD_TRIG_KERNELS(name) \
+LFORTRAN_API LFORTRAN_SIMD_KERNEL void _lfortran_vd##name(int64_t n, void *x, void *y) \
+{ \
+    const double *a = (const double *)x; \
+    double *b = (double *)y; \
+    int64_t i; \
+    if (_lfortran_simd_in_range(n, a, LFORTRAN_SIMD_MAX_REDUCED)) { \
+        for (i = 0; i < n; i++) { \
+            b[i] = _lfortran_simd_##name(a[i]); \
+        } \
+    } else { \
+        for (i = 0; i < n; i++) { \
+            b[i] = name(a[i]); \
+        } \
+    } \
+} \
+\
+LFORTRAN_API LFORTRAN_SIMD_KERNEL void _lfortran_vs##name(int64_t n, void *x, void *y) \
+{ \
+    const float *a = (const float *)x; \
+    float *b = (float *)y; \
+    int64_t i; \
+    if (_lfortran_simd_in_range_f32(n, a, LFORTRAN_SIMD_MAX_REDUCED)) { \
+        for (i = 0; i < n; i++) { \
+            b[i] = (float)_lfortran_simd_##name(a[i]); \
+        } \
+    } else { \
+        for (i = 0; i < n; i++) { \
+            b[i] = name##f(a[i]); \
+        } \
+    } \
+}
+
+LFORTRAN_SIMD_TRIG_KERNELS(sin)
+LFORTRAN_SIMD_TRIG_KERNELS(cos)
+LFORTRAN_SIMD_TRIG_KERNELS(tan)
+
+// Reductions and matrix products ----------------------------------------------
+
+// The kernels below implement the loops which the array_kernels pass replaces.
+// Matrices are stored in column-major order, with the leading dimension `ld`
+// being the distance between two consecutive columns. If the runtime library
+// is built with an external CBLAS (WITH_CBLAS), the dot and matrix products
+// are computed by it instead.
+
+// Number of independent partial sums kept by the reductions, enough to hide
+// the latency of the vector additions
+#define LFORTRAN_SIMD_ACCUMULATORS 32
+
+#define LFORTRAN_SIMD_REDUCTIONS(prefix, type) \
+LFORTRAN_API LFORTRAN_SIMD_KERNEL type _lfortran_v##prefix##sum(int64_t n, void *x) \
+{ \
+    const type *xv = (const type *)x; \
+    type s[LFORTRAN_SIMD_ACCUMULATORS] = {0}; \
+    type r = 0; \
+    int64_t i, j; \
+    for (i = 0; i + LFORTRAN_SIMD_ACCUMULATORS <= n; i += LFORTRAN_SIMD_ACCUMULATORS) { \
+        for (j = 0; j < LFORTRAN_SIMD_ACCUMULATORS; j++) { \
+            s[j] += xv[i + j]; \
+        } \
+    } \
+    for (; i < n; i++) { \
+        r += xv[i]; \
+    } \
+    for (j = 0; j < LFORTRAN_SIMD_ACCUMULATORS; j++) { \
+        r += s[j]; \
+    } \
+    return r; \
+} \
+\
+LFORTRAN_SIMD_KERNEL static type _lfortran_##prefix##dot_kernel(int64_t n, \
+    const void *x, const void *y) \
+{ \
+    const type *xv = (const type *)x, *yv = (const type *)y; \
+    type s[LFORTRAN_SIMD_ACCUMULATORS] = {0}; \
+    type r = 0; \
+    int64_t i, j; \
+    for (i = 0; i + LFORTRAN_SIMD_ACCUMULATORS <= n; i += LFORTRAN_SIMD_ACCUMULATORS) { \
+        for (j = 0; j < LFORTRAN_SIMD_ACCUMULATORS; j++) { \
+            s[j] += xv[i + j] * yv[i + j]; \
+        } \
+    } \
+    for (; i < n; i++) { \
+        r += xv[i] * yv[i]; \
+    } \
+    for (j = 0; j < LFORTRAN_SIMD_ACCUMULATORS; j++) { \
+        r += s[j]; \
+    } \
+    return r; \
+}
+
+// The matrix product C += A B is computed block by block (Goto's algorithm):
+// a KC x NC panel of B and a MC x KC block of A are copied ("packed") into
+// contiguous buffers which fit into the L3 and L2 cache. The micro kernel then
+// keeps a MR x NR block of C in registers while it walks through the packed
+// panels, which are read with unit stride.
+#define LFORTRAN_GEMM_MC 128
+#define LFORTRAN_GEMM_KC 256
+#define LFORTRAN_GEMM_NC 2048
+#define LFORTRAN_GEMM_NR 6
+
+// Products smaller than this (m*n*k) are not worth packing
+#define LFORTRAN_GEMM_MIN_PACKED (48*48*48)
+
+// The transpose B = A^T is done in square tiles, so that both the rows read
+// from A and the columns written to B stay in the L1 cache
+#define LFORTRAN_TRANSPOSE_BLOCK 32
+
+#define LFORTRAN_SIMD_GEMM(prefix, type, MR) \
+static inline void _lfortran_##prefix##gemm_pack_a(int64_t mc, int64_t kc, \
+    const type *a, int64_t lda, type *ap) \
+{ \
+    int64_t i, p, ir; \
+    for (ir = 0; ir < mc; ir += MR) { \
+        int64_t mr = mc - ir < MR ? mc - ir : MR; \
+        for (p = 0; p < kc; p++) { \
+            for (i = 0; i < mr; i++) { \
+                ap[i] = a[(ir + i) + p*lda]; \
+            } \
+            for (; i < MR; i++) { \
+                ap[i] = 0; \
+            } \
+            ap += MR; \
+        } \
+    } \
+} \
+\
+static inline void _lfortran_##prefix##gemm_pack_b(int64_t kc, int64_t nc, \
+    const type *b, int64_t ldb, type *bp) \
+{ \
+    int64_t j, p, jr; \
+    for (jr = 0; jr < nc; jr += LFORTRAN_GEMM_NR) { \
+        int64_t nr = nc - jr < LFORTRAN_GEMM_NR ? nc - jr : LFORTRAN_GEMM_NR; \
+        for (p = 0; p < kc; p++) { \
+            for (j = 0; j < nr; j++) { \
+                bp[j] = b[p + (jr + j)*ldb]; \
+            } \
+            for (; j < LFORTRAN_GEMM_NR; j++) { \
+                bp[j] = 0; \
+            } \
+            bp += LFORTRAN_GEMM_NR; \
+        } \
+    } \
+} \
+\
+LFORTRAN_SIMD_KERNEL static void _lfortran_##prefix##gemm_macro(int64_t mc, \
+    int64_t nc, int64_t kc, const type *ap, const type *bp, type *c, \
+    int64_t ldc) \
+{ \
+    int64_t ir, jr, i, j, p; \
+    for (jr = 0; jr < nc; jr += LFORTRAN_GEMM_NR) { \
+        int64_t nr = nc - jr < LFORTRAN_GEMM_NR ? nc - jr : LFORTRAN_GEMM_NR; \
+        for (ir = 0; ir < mc; ir += MR) { \
+            int64_t mr = mc - ir < MR ? mc - ir : MR; \
+            const type *a = ap + ir*kc, *b = bp + jr*kc; \
+            type acc[LFORTRAN_GEMM_NR][MR] = {{0}}; \
+            for (p = 0; p < kc; p++) { \
+                for (j = 0; j < LFORTRAN_GEMM_NR; j++) { \
+                    type bpj = b[j]; \
+                    for (i = 0; i < MR; i++) { \
+                        acc[j][i] += a[i] * bpj; \
+                    } \
+                } \
+                a += MR; \
+                b += LFORTRAN_GEMM_NR; \
+            } \
+            for (j = 0; j < nr; j++) { \
+                for (i = 0; i < mr; i++) { \
+                    c[(ir + i) + (jr + j)*ldc] += acc[j][i]; \
+                } \
+            } \
+        } \
+    } \
+} \
+\
+static void _lfortran_##prefix##gemm_kernel(int64_t m, int64_t n, int64_t k, \
+    const void *a, int64_t lda, const void *b, int64_t ldb, void *c, \
+    int64_t ldc) \
+{ \
+    const type *av = (const type *)a, *bv = (const type *)b; \
+    type *cv = (type *)c; \
+    type *ap, *bp; \
+    int64_t i, j, p, ic, jc, pc; \
+    if (m <= 0 || n <= 0 || k <= 0) { \
+        return; \
+    } \
+    if (m*n*k < LFORTRAN_GEMM_MIN_PACKED) { \
+        for (j = 0; j < n; j++) { \
+            for (p = 0; p < k; p++) { \
+                type bpj = bv[p + j*ldb]; \
+                for (i = 0; i < m; i++) { \
+                    cv[i + j*ldc] += av[i + p*lda] * bpj; \
+                } \
+            } \
+        } \
+        return; \
+    } \
+    ap = (type *)malloc(sizeof(type) * (LFORTRAN_GEMM_MC + MR) * LFORTRAN_GEMM_KC); \
+    bp = (type *)malloc(sizeof(type) * (LFORTRAN_GEMM_NC + LFORTRAN_GEMM_NR) * LFORTRAN_GEMM_KC); \
+    for (jc = 0; jc < n; jc += LFORTRAN_GEMM_NC) { \
+        int64_t nc = n - jc < LFORTRAN_GEMM_NC ? n - jc : LFORTRAN_GEMM_NC; \
+        for (pc = 0; pc < k; pc += LFORTRAN_GEMM_KC) { \
+            int64_t kc = k - pc < LFORTRAN_GEMM_KC ? k - pc : LFORTRAN_GEMM_KC; \
+            _lfortran_##prefix##gemm_pack_b(kc, nc, bv + pc + jc*ldb, ldb, bp); \
+            for (ic = 0; ic < m; ic += LFORTRAN_GEMM_MC) { \
+                int64_t mc = m - ic < LFORTRAN_GEMM_MC ? m - ic : LFORTRAN_GEMM_MC; \
+                _lfortran_##prefix##gemm_pack_a(mc, kc, av + ic + pc*lda, lda, ap); \
+                _lfortran_##prefix##gemm_macro(mc, nc, kc, ap, bp, \
+                    cv + ic + jc*ldc, ldc); \
+            } \
+        } \
+    } \
+    free(ap); \
+    free(bp); \
+} \
+\
+LFORTRAN_API void _lfortran_v##prefix##transpose(int64_t m, int64_t n, \
+    void *a, int64_t lda, void *b, int64_t ldb) \
+{ \
+    const type *av = (const type *)a; \
+    type *bv = (type *)b; \
+    int64_t i, j, ib, jb; \
+    for (jb = 0; jb < n; jb += LFORTRAN_TRANSPOSE_BLOCK) { \
+        int64_t je = n - jb < LFORTRAN_TRANSPOSE_BLOCK ? n : jb + LFORTRAN_TRANSPOSE_BLOCK; \
+        for (ib = 0; ib < m; ib += LFORTRAN_TRANSPOSE_BLOCK) { \
+            int64_t ie = m - ib < LFORTRAN_TRANSPOSE_BLOCK ? m : ib + LFORTRAN_TRANSPOSE_BLOCK; \
+            for (j = jb; j < je; j++) { \
+                for (i = ib; i < ie; i++) { \
+                    bv[j + i*ldb] = av[i + j*lda]; \
+                } \
+            } \
+        } \
+    } \
+}
+
+LFORTRAN_SIMD_REDUCTIONS(d, double)
+LFORTRAN_SIMD_REDUCTIONS(s, float)
+LFORTRAN_SIMD_GEMM(d, double, 8)
+LFORTRAN_SIMD_GEMM(s, float, 32)
+
+LFORTRAN_API double _lfortran_vddot(int64_t n, void *x, void *y)
+{
+#ifdef HAVE_LFORTRAN_CBLAS
+    return cblas_ddot(n, (const double *)x, 1, (const double *)y, 1);
+#else
+    return _lfortran_ddot_kernel(n, x, y);
+#endif
+}
+
+LFORTRAN_API float _lfortran_vsdot(int64_t n, void *x, void *y)
+{
+#ifdef HAVE_LFORTRAN_CBLAS
+    return cblas_sdot(n, (const float *)x, 1, (const float *)y, 1);
+#else
+    return _lfortran_sdot_kernel(n, x, y);
+#endif
+}
+
+LFORTRAN_API void _lfortran_vdgemm(int64_t m, int64_t n, int64_t k, void *a,
+    int64_t lda, void *b, int64_t ldb, void *c, int64_t ldc)
+{
+#ifdef HAVE_LFORTRAN_CBLAS
+    if (m > 0 && n > 0 && k > 0) {
+        cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m, n, k, 1.0,
+            (const double *)a, lda, (const double *)b, ldb, 1.0,
+            (double *)c, ldc);
+    }
+#else
+    _lfortran_dgemm_kernel(m, n, k, a, lda, b, ldb, c, ldc);
+#endif
+}
+
+LFORTRAN_API void _lfortran_vsgemm(int64_t m, int64_t n, int64_t k, void *a,
+    int64_t lda, void *b, int64_t ldb, void *c, int64_t ldc)
+{
+#ifdef HAVE_LFORTRAN_CBLAS
+    if (m > 0 && n > 0 && k > 0) {
+        cblas_sgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m, n, k, 1.0f,
+            (const float *)a, lda, (const float *)b, ldb, 1.0f,
+            (float *)c, ldc);
+    }
+#else
+    _lfortran_sgemm_kernel(m, n, k, a, lda, b, ldb, c, ldc);
+#endif
+}
+
 
 // strcat  --------------------------------------------------------------------
 
@@ -137,6 +137,30 @@ LFORTRAN_API float _lfortran_satanh(float x);
 LFORTRAN_API double _lfortran_datanh(double x);
 LFORTRAN_API float_complex_t _lfortran_catanh(float_complex_t x);
 LFORTRAN_API double_complex_t _lfortran_zatanh(double_complex_t x);
+LFORTRAN_API void _lfortran_vdsin(int64_t n, void *x, void *y);
+LFORTRAN_API void _lfortran_vssin(int64_t n, void *x, void *y);
+LFORTRAN_API void _lfortran_vdcos(int64_t n, void *x, void *y);
+LFORTRAN_API void _lfortran_vscos(int64_t n, void *x, void *y);
+LFORTRAN_API void _lfortran_vdtan(int64_t n, void *x, void *y);
+LFORTRAN_API void _lfortran_vstan(int64_t n, void *x, void *y);
+LFORTRAN_API void _lfortran_vdexp(int64_t n, void *x, void *y);
+LFORTRAN_API void _lfortran_vsexp(int64_t n, void *x, void *y);
+LFORTRAN_API void _lfortran_vdlog(int64_t n, void *x, void *y);
+LFORTRAN_API void _lfortran_vslog(int64_t n, void *x, void *y);
+LFORTRAN_API void _lfortran_vdtanh(int64_t n, void *x, void *y);
+LFORTRAN_API void _lfortran_vstanh(int64_t n, void *x, void *y);
+LFORTRAN_API double _lfortran_vdsum(int64_t n, void *x);
+LFORTRAN_API float _lfortran_vssum(int64_t n, void *x);
+LFORTRAN_API double _lfortran_vddot(int64_t n, void *x, void *y);
+LFORTRAN_API float _lfortran_vsdot(int64_t n, void *x, void *y);
+LFORTRAN_API void _lfortran_vdgemm(int64_t m, int64_t n, int64_t k, void *a,
+    int64_t lda, void *b, int64_t ldb, void *c, int64_t ldc);
+LFORTRAN_API void _lfortran_vsgemm(int64_t m, int64_t n, int64_t k, void *a,
+    int64_t lda, void *b, int64_t ldb, void *c, int64_t ldc);
+LFORTRAN_API void _lfortran_vdtranspose(int64_t m, int64_t n, void *a,
+    int64_t lda, void *b, int64_t ldb);
+LFORTRAN_API void _lfortran_vstranspose(int64_t m, int64_t n, void *a,
+    int64_t lda, void *b, int64_t ldb);
 LFORTRAN_API bool _lpython_str_compare_eq(char** s1, char** s2);
 LFORTRAN_API bool _lpython_str_compare_noteq(char** s1, char** s2);
 LFORTRAN_API bool _lpython_str_compare_gt(char** s1, char** s2);
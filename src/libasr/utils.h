@@ -3,11 +3,16 @@
 
 #include <string>
 #include <vector>
+#include <set>
 #include <filesystem>
 #include <libasr/containers.h>
 
 namespace LFortran {
 
+namespace diag {
+    struct Diagnostics;
+}
+
 enum Platform {
     Linux,
     macOS_Intel,
@@ -48,10 +53,19 @@ struct CompilerOptions {
     bool implicit_interface = false;
     bool rtlib = false;
     std::string target = "";
+    std::string target_cpu = "";
     std::string arg_o = "";
     bool emit_debug_info = false;
     bool emit_debug_line_column = false;
     std::string import_path = "";
+    std::string object_cache_dir = "";
+    bool separate_compilation = false;
+    bool lazy_module_bodies = false;
+    bool profile_generate = false;
+    std::string profile_use = "";
+    bool remarks = false;
+    int64_t inline_threshold = 40;
+    int64_t inline_budget = 400;
     Platform platform;
 
     CompilerOptions () : platform{get_platform()} {};
@@ -75,8 +89,22 @@ namespace LCompilers {
         std::string runtime_library_dir;
         bool always_run = false; // for unused_functions pass
         bool inline_external_symbol_calls = true; // for inline_function_calls pass
+        // Cost model of the inline_function_calls pass: a call is inlined
+        // if the size of the callee (statements and expressions, less the
+        // ones its constant arguments fold) is at most the threshold, which
+        // grows with the loop depth of the call; a function grows by at
+        // most the budget
+        int64_t inline_threshold = 40;
+        int64_t inline_budget = 400;
         int64_t unroll_factor = 32; // for loop_unroll pass
         bool fast = false; // is fast flag enabled.
+        // The backend emits a jump table for a select (select_case pass)
+        bool native_switch = false;
+        // Functions that are cold in the `--profile-use` profile, for the
+        // inline_function_calls and loop_unroll passes
+        std::set<std::string> cold_functions;
+        // If set, the passes report their decisions here (as notes)
+        LFortran::diag::Diagnostics *remarks = nullptr;
     };
 
 }
@@ -3,6 +3,7 @@
 #include <windows.h>
 #endif
 
+#include <cstring>
 #include <fstream>
 
 #include <libasr/exception.h>
@@ -30,7 +31,7 @@ bool read_file(const std::string &filename, std::string &text)
 
 bool present(Vec<char*> &v, const char* name) {
     for (auto &a : v) {
-        if (std::string(a) == std::string(name)) {
+        if (std::strcmp(a, name) == 0) {
             return true;
         }
     }
@@ -39,7 +40,7 @@ bool present(Vec<char*> &v, const char* name) {
 
 bool present(char** const v, size_t n, const std::string name) {
     for (size_t i = 0; i < n; i++) {
-        if (std::string(v[i]) == name) {
+        if (std::strcmp(v[i], name.c_str()) == 0) {
             return true;
         }
     }
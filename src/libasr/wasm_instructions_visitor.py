@@ -140,7 +140,8 @@ param_read_function = {
     "int32_t": "wasm::read_i32",
     "int64_t": "wasm::read_i64",
     "float": "wasm::read_f32",
-    "double": "wasm::read_f64"
+    "double": "wasm::read_f64",
+    "std::vector<uint32_t>": "wasm::read_vec_u32"
 }
 
 param_type = {
@@ -150,6 +151,7 @@ param_type = {
     "i64": "int64_t",
     "f32": "float",
     "f64": "double",
+    "vec(u32)": "std::vector<uint32_t>",
 }
 
 def parse_param_info(param_info):
@@ -25,7 +25,8 @@ PythonCompiler::PythonCompiler(CompilerOptions compiler_options)
     :
     al{1024*1024},
 #ifdef HAVE_LFORTRAN_LLVM
-    e{std::make_unique<LLVMEvaluator>()},
+    e{std::make_unique<LLVMEvaluator>(compiler_options.target,
+        compiler_options.target_cpu)},
     eval_count{0},
 #endif
     compiler_options{compiler_options}
@@ -63,8 +64,10 @@ Result<std::unique_ptr<LLVMModule>> PythonCompiler::get_llvm3(
         return res.error;
     }
 
-    if (compiler_options.fast) {
-        e->opt(*m->m_m);
+    if (compiler_options.fast || compiler_options.profile_generate
+            || !compiler_options.profile_use.empty()) {
+        e->opt(*m->m_m, compiler_options.profile_generate,
+            compiler_options.profile_use);
     }
 
     return m;
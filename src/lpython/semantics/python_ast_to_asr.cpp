@@ -1,6 +1,8 @@
 #include <fstream>
 #include <iostream>
+#include <list>
 #include <map>
+#include <unordered_map>
 #include <set>
 #include <memory>
 #include <string>
@@ -190,7 +192,10 @@ LFortran::Result<std::string> get_full_path(const std::string &filename,
     ltypes = false;
     enum_py = false;
     std::string file_path;
-    if( *(runtime_library_dir.rbegin()) == '/' ) {
+    if( runtime_library_dir.empty() ) {
+        // The parent directory of a file given without a path
+        file_path = filename;
+    } else if( *(runtime_library_dir.rbegin()) == '/' ) {
         file_path = runtime_library_dir + filename;
     } else {
         file_path = runtime_library_dir + "/" + filename;
@@ -245,6 +250,35 @@ bool set_module_path(std::string infile0, std::vector<std::string> &rl_path,
     return false;
 }
 
+// With `--lazy-module-bodies` the imported modules are compiled without the
+// bodies of their functions. The AST of every function is remembered here and
+// its body is lowered once a reference to the function is found in code that
+// is itself lowered (see `lower_demanded_function_bodies`).
+struct PendingFunctionBody {
+    const AST::FunctionDef_t *ast;
+    ASR::Module_t *module;
+    std::map<int, ASR::symbol_t*> *ast_overload;
+    bool allow_implicit_casting;
+};
+
+struct LazyModuleBodies {
+    bool enabled = false;
+    std::map<ASR::Function_t*, PendingFunctionBody> pending;
+    std::list<std::map<int, ASR::symbol_t*>> ast_overloads;
+    // Functions with the Source ABI before `load_module` marked the module
+    // intrinsic
+    std::map<ASR::Module_t*, std::vector<ASR::Function_t*>> source_functions;
+
+    void clear() {
+        enabled = false;
+        pending.clear();
+        ast_overloads.clear();
+        source_functions.clear();
+    }
+};
+
+static thread_local LazyModuleBodies lazy_module_bodies;
+
 ASR::TranslationUnit_t* compile_module_till_asr(Allocator& al,
         std::vector<std::string> &rl_path, std::string infile,
         const Location &loc, diag::Diagnostics &diagnostics, LocationManager &lm,
@@ -314,7 +348,7 @@ ASR::Module_t* load_module(Allocator &al, SymbolTable *symtab,
         return nullptr;
     }
     LFORTRAN_ASSERT(symtab);
-    if (symtab->get_scope().find(module_name) != symtab->get_scope().end()) {
+    if (symtab->get_symbol(module_name) != nullptr) {
         ASR::symbol_t *m = symtab->get_symbol(module_name);
         if (ASR::is_a<ASR::Module_t>(*m)) {
             return ASR::down_cast<ASR::Module_t>(m);
@@ -395,6 +429,9 @@ ASR::Module_t* load_module(Allocator &al, SymbolTable *symtab,
             a_mod->m_intrinsic = intrinsic;
             mod2 = a_mod;
         }
+        if( !compile_module ) {
+            a_mod->m_loaded_from_mod = true;
+        }
         symtab->add_symbol(a_name, (ASR::symbol_t*)a_mod);
         a_mod->m_symtab->parent = symtab;
     }
@@ -432,7 +469,7 @@ ASR::symbol_t* import_from_module(Allocator &al, ASR::Module_t *m, SymbolTable *
                 loc);
     }
     if (!skip_current_scope_check &&
-        current_scope->get_scope().find(new_sym_name) != current_scope->get_scope().end()) {
+        current_scope->get_symbol(new_sym_name) != nullptr) {
         throw SemanticError(new_sym_name + " already defined", loc);
     }
     if (ASR::is_a<ASR::Function_t>(*t)) {
@@ -542,8 +579,15 @@ public:
     AST::expr_t* assign_ast_target;
     bool is_c_p_pointer_call;
 
-    std::map<std::string, int> generic_func_nums;
-    std::map<std::string, std::map<std::string, ASR::ttype_t*>> generic_func_subs;
+    // The instantiations of a generic function, by the signature of their
+    // type substitution (see `generic_signature`)
+    struct GenericInstantiations {
+        // The number of instantiations, the next one gets this number
+        int count = 0;
+        std::unordered_map<std::string, std::vector<std::pair<
+            std::map<std::string, ASR::ttype_t*>, ASR::symbol_t*>>> by_signature;
+    };
+    std::map<ASR::Function_t*, GenericInstantiations> generic_instantiations;
     std::vector<ASR::symbol_t*> rt_vec;
     std::set<std::string> dependencies;
     bool allow_implicit_casting;
@@ -1331,48 +1375,125 @@ public:
         throw SemanticError("No applicable argument to the restriction " + rt_name , loc);
     }
 
+    /**
+     * @brief Returns a key for the type `t` that is equal for all the types
+     *        that `check_equal_type` considers equal (it can also be equal
+     *        for some types that are not).
+     */
+    std::string generic_type_key(ASR::ttype_t *t) {
+        while (true) {
+            if (ASR::is_a<ASR::Enum_t>(*t)) {
+                ASR::Enum_t *e = ASR::down_cast<ASR::Enum_t>(t);
+                t = ASR::down_cast<ASR::EnumType_t>(e->m_enum_type)->m_type;
+            } else if (ASR::is_a<ASR::Pointer_t>(*t)) {
+                t = ASR::down_cast<ASR::Pointer_t>(t)->m_type;
+            } else if (ASR::is_a<ASR::Const_t>(*t)) {
+                t = ASR::down_cast<ASR::Const_t>(t)->m_type;
+            } else {
+                break;
+            }
+        }
+        std::string key = std::to_string(t->type);
+        switch (t->type) {
+            case ASR::ttypeType::Integer:
+                return key + "_" + std::to_string(ASR::down_cast<ASR::Integer_t>(t)->m_kind);
+            case ASR::ttypeType::Real:
+                return key + "_" + std::to_string(ASR::down_cast<ASR::Real_t>(t)->m_kind);
+            case ASR::ttypeType::List:
+                return key + "(" + generic_type_key(ASR::down_cast<ASR::List_t>(t)->m_type) + ")";
+            case ASR::ttypeType::Set:
+                return key + "(" + generic_type_key(ASR::down_cast<ASR::Set_t>(t)->m_type) + ")";
+            case ASR::ttypeType::Dict: {
+                ASR::Dict_t *d = ASR::down_cast<ASR::Dict_t>(t);
+                return key + "(" + generic_type_key(d->m_key_type) + ","
+                    + generic_type_key(d->m_value_type) + ")";
+            }
+            case ASR::ttypeType::Tuple: {
+                ASR::Tuple_t *tuple = ASR::down_cast<ASR::Tuple_t>(t);
+                key += "(";
+                for (size_t i = 0; i < tuple->n_type; i++) {
+                    key += generic_type_key(tuple->m_type[i]) + ",";
+                }
+                return key + ")";
+            }
+            case ASR::ttypeType::TypeParameter:
+                return key + "_" + ASR::down_cast<ASR::TypeParameter_t>(t)->m_param;
+            default:
+                return key;
+        }
+    }
+
+    // The canonical signature of the type substitution `subs`
+    std::string generic_signature(const std::map<std::string, ASR::ttype_t*> &subs) {
+        std::string signature;
+        for (auto &sub: subs) {
+            signature += sub.first + ":" + generic_type_key(sub.second) + ";";
+        }
+        return signature;
+    }
+
+    /**
+     * @brief Returns the instantiations of the generic function `func`. The
+     *        first time, they are collected from the instantiations already
+     *        in the ASR (made by other modules, or loaded from `.pyc` files),
+     *        so that every module shares them.
+     */
+    GenericInstantiations &get_generic_instantiations(ASR::Function_t *func) {
+        auto it = generic_instantiations.find(func);
+        if (it != generic_instantiations.end()) {
+            return it->second;
+        }
+        GenericInstantiations &insts = generic_instantiations[func];
+        SymbolTable *scope = func->m_symtab->parent;
+        std::string prefix = "__lpython_generic_" + std::string(func->m_name) + "_";
+        while (ASR::symbol_t *s = scope->get_symbol(prefix + std::to_string(insts.count))) {
+            // Recover the type substitution from the argument types
+            ASR::Function_t *f = ASR::down_cast<ASR::Function_t>(s);
+            std::map<std::string, ASR::ttype_t*> subs;
+            for (size_t i = 0; i < func->n_args && i < f->n_args; i++) {
+                check_type_substitution(subs, ASRUtils::expr_type(func->m_args[i]),
+                    ASRUtils::expr_type(f->m_args[i]), f->base.base.loc);
+            }
+            insts.by_signature[generic_signature(subs)].push_back({subs, s});
+            insts.count++;
+        }
+        return insts;
+    }
+
     /**
      * @brief Check if the generic function has been instantiated with similar
      *        arguments. If not, then instantiate a new function.
      */
     ASR::symbol_t* get_generic_function(std::map<std::string, ASR::ttype_t*> subs,
             std::map<std::string, ASR::symbol_t*> rt_subs, ASR::Function_t *func) {
-        int new_function_num;
-        ASR::symbol_t *t;
         std::string func_name = func->m_name;
-        if (generic_func_nums.find(func_name) != generic_func_nums.end()) {
-            new_function_num = generic_func_nums[func_name];
-            for (int i=0; i<generic_func_nums[func_name]; i++) {
-                std::string generic_func_name = "__lpython_generic_" + func_name + "_" + std::to_string(i);
-                if (generic_func_subs.find(generic_func_name) != generic_func_subs.end()) {
-                    std::map<std::string, ASR::ttype_t*> subs_check = generic_func_subs[generic_func_name];
-                    if (subs_check.size() != subs.size()) { continue; }
-                    bool defined = true;
-                    for (auto const &subs_check_pair: subs_check) {
-                        if (subs.find(subs_check_pair.first) == subs.end()) {
-                            defined = false; break;
-                        }
-                        ASR::ttype_t* subs_type = subs[subs_check_pair.first];
-                        ASR::ttype_t* subs_check_type = subs_check_pair.second;
-                        if (!ASRUtils::check_equal_type(subs_type, subs_check_type)) {
-                            defined = false; break;
-                        }
-                    }
-                    if (defined) {
-                        t = current_scope->resolve_symbol(generic_func_name);
-                        return t;
-                    }
+        GenericInstantiations &insts = get_generic_instantiations(func);
+        std::string signature = generic_signature(subs);
+        auto &candidates = insts.by_signature[signature];
+        for (auto &candidate: candidates) {
+            std::map<std::string, ASR::ttype_t*> &subs_check = candidate.first;
+            if (subs_check.size() != subs.size()) { continue; }
+            bool defined = true;
+            for (auto const &subs_check_pair: subs_check) {
+                if (subs.find(subs_check_pair.first) == subs.end()) {
+                    defined = false; break;
+                }
+                ASR::ttype_t* subs_type = subs[subs_check_pair.first];
+                ASR::ttype_t* subs_check_type = subs_check_pair.second;
+                if (!ASRUtils::check_equal_type(subs_type, subs_check_type)) {
+                    defined = false; break;
                 }
             }
-        } else {
-            new_function_num = 0;
+            if (defined) {
+                return candidate.second;
+            }
         }
-        generic_func_nums[func_name] = new_function_num + 1;
         std::string new_func_name = "__lpython_generic_" + func_name + "_"
-            + std::to_string(new_function_num);
-        generic_func_subs[new_func_name] = subs;
-        t = pass_instantiate_generic_function(al, subs, rt_subs, current_scope,
-                new_func_name, func);
+            + std::to_string(insts.count);
+        insts.count++;
+        ASR::symbol_t *t = pass_instantiate_generic_function(al, subs, rt_subs,
+                current_scope, new_func_name, func);
+        candidates.push_back({subs, t});
         dependencies.erase(func_name);
         dependencies.insert(new_func_name);
         return t;
@@ -3286,7 +3407,7 @@ public:
                                         0,
                                         false, false);
 
-            if (parent_scope->get_scope().find(mod_name) != parent_scope->get_scope().end()) {
+            if (parent_scope->get_symbol(mod_name) != nullptr) {
                 throw SemanticError("Module '" + mod_name + "' already defined", tmp1->loc);
             }
             module_sym = ASR::down_cast<ASR::Module_t>(ASR::down_cast<ASR::symbol_t>(tmp1));
@@ -3369,7 +3490,7 @@ public:
             }
             sym_name = "__lpython_overloaded_" + overload_number + "__" + sym_name;
         }
-        if (parent_scope->get_scope().find(sym_name) != parent_scope->get_scope().end()) {
+        if (parent_scope->get_symbol(sym_name) != nullptr) {
             throw SemanticError("Function " + std::string(x.m_name) +  " is already defined", x.base.base.loc);
         }
 
@@ -3460,7 +3581,7 @@ public:
                     variable_dependencies_vec.size(), ASRUtils::intent_return_var,
                     nullptr, nullptr, storage_type, type, current_procedure_abi_type, ASR::Public,
                     ASR::presenceType::Required, false);
-                LFORTRAN_ASSERT(current_scope->get_scope().find(return_var_name) == current_scope->get_scope().end())
+                LFORTRAN_ASSERT(current_scope->get_symbol(return_var_name) == nullptr)
                 current_scope->add_symbol(return_var_name,
                         ASR::down_cast<ASR::symbol_t>(return_var));
                 ASR::asr_t *return_var_ref = ASR::make_Var_t(al, x.base.base.loc,
@@ -3731,8 +3852,7 @@ public:
                             }
                         }
                         // Check if the type variable is already defined
-                        if (current_scope->get_scope().find(tvar_name) !=
-                                current_scope->get_scope().end()) {
+                        if (current_scope->get_symbol(tvar_name) != nullptr) {
                             ASR::symbol_t *orig_decl = current_scope->get_symbol(tvar_name);
                             throw SemanticError(diag::Diagnostic(
                                 "Variable " + tvar_name + " is already declared in the same scope",
@@ -3816,6 +3936,10 @@ public:
     ASR::asr_t *asr;
     std::map<std::string, std::tuple<int64_t, bool, Location>> goto_name2id;
     int64_t gotoids;
+    // Set for imported modules compiled with `--lazy-module-bodies`, the
+    // function bodies of `lazy_module` are then lowered on demand
+    ASR::Module_t *lazy_module = nullptr;
+    std::map<int, ASR::symbol_t*> *lazy_ast_overload = nullptr;
 
 
     BodyVisitor(Allocator &al, LocationManager &lm, ASR::asr_t *unit, diag::Diagnostics &diagnostics,
@@ -3869,6 +3993,19 @@ public:
         if (!main_module) {
             current_scope = mod->m_symtab;
             LFORTRAN_ASSERT(current_scope != nullptr);
+            if (lazy_module_bodies.enabled) {
+                lazy_module = mod;
+                lazy_module_bodies.ast_overloads.push_back(ast_overload);
+                lazy_ast_overload = &lazy_module_bodies.ast_overloads.back();
+                for (auto &item : mod->m_symtab->get_scope()) {
+                    if (ASR::is_a<ASR::Function_t>(*item.second)) {
+                        ASR::Function_t *f = ASR::down_cast<ASR::Function_t>(item.second);
+                        if (f->m_abi == ASR::abiType::Source) {
+                            lazy_module_bodies.source_functions[mod].push_back(f);
+                        }
+                    }
+                }
+            }
         }
 
         Vec<ASR::asr_t*> items;
@@ -3928,7 +4065,35 @@ public:
         rt_vec.clear();
     }
 
+    // Registers the body of a module level function to be lowered once the
+    // function is referenced. Generic functions are instantiated from their
+    // body by the callers, so those are lowered right away.
+    bool defer_function_body(const AST::FunctionDef_t &x) {
+        if (current_scope != lazy_module->m_symtab) {
+            return false;
+        }
+        ASR::symbol_t *t = current_scope->get_symbol(x.m_name);
+        if (ASR::is_a<ASR::GenericProcedure_t>(*t)) {
+            t = ast_overload[(int64_t)&x];
+        }
+        if (!ASR::is_a<ASR::Function_t>(*t)) {
+            return false;
+        }
+        ASR::Function_t *f = ASR::down_cast<ASR::Function_t>(t);
+        if (f->m_deftype != ASR::deftypeType::Implementation
+                || f->n_type_params > 0 || f->m_is_restriction) {
+            return false;
+        }
+        lazy_module_bodies.pending[f] = {&x, lazy_module, lazy_ast_overload,
+            allow_implicit_casting};
+        return true;
+    }
+
     void visit_FunctionDef(const AST::FunctionDef_t &x) {
+        if (lazy_module && defer_function_body(x)) {
+            tmp = nullptr;
+            return;
+        }
         goto_name2id.clear();
         gotoids = 0;
         SymbolTable *old_scope = current_scope;
@@ -3978,8 +4143,7 @@ public:
                 x.base.base.loc);
         }
 
-        if (current_scope->get_scope().find(var_name) !=
-                current_scope->get_scope().end()) {
+        if (current_scope->get_symbol(var_name) != nullptr) {
             if (current_scope->parent != nullptr) {
                 // Re-declaring a global scope variable is allowed,
                 // otherwise raise an error
@@ -6119,6 +6283,161 @@ Result<ASR::TranslationUnit_t*> body_visitor(Allocator &al, LocationManager &lm,
     return tu;
 }
 
+Result<bool> lower_function_body(Allocator &al, LocationManager &lm,
+        diag::Diagnostics &diagnostics, const PendingFunctionBody &p)
+{
+    // The body is lowered as it would have been while the module was being
+    // constructed, before `load_module` marked it intrinsic
+    bool intrinsic = p.module->m_intrinsic;
+    std::vector<ASR::Function_t*> &source_functions
+        = lazy_module_bodies.source_functions[p.module];
+    if (intrinsic) {
+        p.module->m_intrinsic = false;
+        for (auto &f : source_functions) {
+            f->m_abi = ASR::abiType::Source;
+        }
+    }
+    BodyVisitor b(al, lm, nullptr, diagnostics, false, *p.ast_overload,
+        p.allow_implicit_casting);
+    b.current_scope = p.module->m_symtab;
+    b.current_module = p.module;
+    Result<bool> res = true;
+    try {
+        b.visit_FunctionDef(*p.ast);
+    } catch (const SemanticError &e) {
+        diagnostics.diagnostics.push_back(e.d);
+        res = Error();
+    } catch (const SemanticAbort &) {
+        res = Error();
+    }
+    if (intrinsic) {
+        p.module->m_intrinsic = true;
+        for (auto &f : source_functions) {
+            f->m_abi = ASR::abiType::Intrinsic;
+        }
+    }
+    return res;
+}
+
+class DemandedFunctionsVisitor :
+    public ASR::BaseWalkVisitor<DemandedFunctionsVisitor>
+{
+public:
+    std::vector<std::pair<ASR::Function_t*, PendingFunctionBody>> demanded;
+
+    void demand(const ASR::symbol_t *s) {
+        s = ASRUtils::symbol_get_past_external(s);
+        if (ASR::is_a<ASR::GenericProcedure_t>(*s)) {
+            ASR::GenericProcedure_t *g = ASR::down_cast<ASR::GenericProcedure_t>(s);
+            for (size_t i = 0; i < g->n_procs; i++) {
+                demand(g->m_procs[i]);
+            }
+        } else if (ASR::is_a<ASR::Function_t>(*s)) {
+            ASR::Function_t *f = ASR::down_cast<ASR::Function_t>(s);
+            auto it = lazy_module_bodies.pending.find(f);
+            if (it != lazy_module_bodies.pending.end()) {
+                demanded.push_back(*it);
+                lazy_module_bodies.pending.erase(it);
+            }
+        }
+    }
+
+    void visit_FunctionCall(const ASR::FunctionCall_t &x) {
+        demand(x.m_name);
+        if (x.m_original_name) {
+            demand(x.m_original_name);
+        }
+        ASR::BaseWalkVisitor<DemandedFunctionsVisitor>::visit_FunctionCall(x);
+    }
+
+    void visit_SubroutineCall(const ASR::SubroutineCall_t &x) {
+        demand(x.m_name);
+        if (x.m_original_name) {
+            demand(x.m_original_name);
+        }
+        ASR::BaseWalkVisitor<DemandedFunctionsVisitor>::visit_SubroutineCall(x);
+    }
+
+    void visit_Var(const ASR::Var_t &x) {
+        // Functions passed as callbacks
+        demand(x.m_v);
+    }
+};
+
+// Erases the symbols referring to the `removed` ones: GenericProcedures
+// lose the removed procedures (and are removed once empty), ExternalSymbols
+// pointing to a removed symbol are removed
+void remove_symbol_references(SymbolTable *symtab,
+        std::set<ASR::symbol_t*> &removed, bool generic_procedures)
+{
+    std::vector<std::string> erased;
+    for (auto &item : symtab->get_scope()) {
+        ASR::symbol_t *sym = item.second;
+        if (generic_procedures && ASR::is_a<ASR::GenericProcedure_t>(*sym)) {
+            ASR::GenericProcedure_t *g = ASR::down_cast<ASR::GenericProcedure_t>(sym);
+            size_t n = 0;
+            for (size_t i = 0; i < g->n_procs; i++) {
+                if (removed.find(ASRUtils::symbol_get_past_external(
+                        g->m_procs[i])) == removed.end()) {
+                    g->m_procs[n++] = g->m_procs[i];
+                }
+            }
+            g->n_procs = n;
+            if (n == 0) {
+                removed.insert(sym);
+                erased.push_back(item.first);
+            }
+        } else if (!generic_procedures && ASR::is_a<ASR::ExternalSymbol_t>(*sym)) {
+            if (removed.find(ASR::down_cast<ASR::ExternalSymbol_t>(sym)->m_external)
+                    != removed.end()) {
+                erased.push_back(item.first);
+            }
+        } else {
+            SymbolTable *sym_symtab = ASRUtils::symbol_symtab(sym);
+            if (sym_symtab) {
+                remove_symbol_references(sym_symtab, removed, generic_procedures);
+            }
+        }
+    }
+    for (auto &name : erased) {
+        symtab->erase_symbol(name);
+    }
+}
+
+// Lowers the bodies of all pending functions reachable from `tu`, the
+// functions that are never referenced are removed.
+Result<bool> lower_demanded_function_bodies(Allocator &al, LocationManager &lm,
+        ASR::TranslationUnit_t &tu, diag::Diagnostics &diagnostics)
+{
+    DemandedFunctionsVisitor v;
+    v.visit_TranslationUnit(tu);
+    for (size_t i = 0; i < tu.n_items; i++) {
+        if (tu.m_items[i]->type == ASR::asrType::expr) {
+            v.visit_expr(*ASRUtils::EXPR(tu.m_items[i]));
+        } else if (tu.m_items[i]->type == ASR::asrType::stmt) {
+            v.visit_stmt(*ASRUtils::STMT(tu.m_items[i]));
+        }
+    }
+    while (!v.demanded.empty()) {
+        std::pair<ASR::Function_t*, PendingFunctionBody> f = v.demanded.back();
+        v.demanded.pop_back();
+        auto res = lower_function_body(al, lm, diagnostics, f.second);
+        if (!res.ok) {
+            return res.error;
+        }
+        v.visit_Function(*f.first);
+    }
+    std::set<ASR::symbol_t*> removed;
+    for (auto &item : lazy_module_bodies.pending) {
+        ASR::Function_t *f = item.first;
+        f->m_symtab->parent->erase_symbol(f->m_name);
+        removed.insert((ASR::symbol_t*)f);
+    }
+    remove_symbol_references(tu.m_global_scope, removed, true);
+    remove_symbol_references(tu.m_global_scope, removed, false);
+    return true;
+}
+
 class PickleVisitor : public AST::PickleBaseVisitor<PickleVisitor>
 {
 public:
@@ -6166,6 +6485,10 @@ Result<ASR::TranslationUnit_t*> python_ast_to_asr(Allocator &al, LocationManager
     std::map<int, ASR::symbol_t*> ast_overload;
     std::string parent_dir = get_parent_dir(file_path);
     AST::Module_t *ast_m = AST::down_cast2<AST::Module_t>(&ast);
+    if (main_module) {
+        lazy_module_bodies.clear();
+        lazy_module_bodies.enabled = compiler_options.lazy_module_bodies;
+    }
 
     ASR::asr_t *unit;
     auto res = symbol_table_visitor(al, lm, *ast_m, diagnostics, main_module,
@@ -6191,6 +6514,13 @@ Result<ASR::TranslationUnit_t*> python_ast_to_asr(Allocator &al, LocationManager
         } else {
             return res2.error;
         }
+        if (main_module && lazy_module_bodies.enabled) {
+            auto res3 = lower_demanded_function_bodies(al, lm, *tu, diagnostics);
+            lazy_module_bodies.clear();
+            if (!res3.ok) {
+                return res3.error;
+            }
+        }
 #if defined(WITH_LFORTRAN_ASSERT)
         diag::Diagnostics diagnostics;
         if (!asr_verify(*tu, true, diagnostics)) {
@@ -6200,6 +6530,19 @@ Result<ASR::TranslationUnit_t*> python_ast_to_asr(Allocator &al, LocationManager
 #endif
     }
 
+    if (compiler_options.separate_compilation) {
+        // Modules loaded from a `.pyc` file are compiled separately, we
+        // only keep their interface and link against their object files
+        for (auto &item : tu->m_global_scope->get_scope()) {
+            if (ASR::is_a<ASR::Module_t>(*item.second)) {
+                ASR::Module_t *m = ASR::down_cast<ASR::Module_t>(item.second);
+                if (m->m_loaded_from_mod && !m->m_intrinsic) {
+                    m->m_symtab->mark_all_variables_external(al);
+                }
+            }
+        }
+    }
+
     if (main_module) {
         // If it is a main module, turn it into a program
         // Note: we can modify this behavior for interactive mode later
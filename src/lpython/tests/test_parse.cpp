@@ -6,6 +6,7 @@
 #include <string>
 
 #include <lpython/bigint.h>
+#include <libasr/asr_scopes.h>
 
 using LFortran::TRY;
 using LFortran::Result;
@@ -295,3 +296,102 @@ TEST_CASE("Test LFortran::Allocator 2") {
     // Must manually call the destructor:
     v->~vector<int>();
 }
+
+TEST_CASE("Test LFortran::Allocator recycling") {
+    Allocator al(1024);
+    // Too small to be recycled
+    void *p = al.alloc(16);
+    al.recycle(p, 16);
+    CHECK(al.stats().lost == 16);
+    CHECK(al.alloc_reuse(16) != p);
+
+    // A block of 100 bytes is in the size class 64, so it can only be
+    // reused for up to 64 bytes
+    p = al.alloc(100);
+    al.recycle(p, 100);
+    CHECK(al.stats().free == 64);
+    CHECK(al.alloc_reuse(65) != p);
+    CHECK(al.alloc_reuse(64) == p);
+    CHECK(al.stats().free == 0);
+    CHECK(al.stats().reused == 64);
+
+    // Memory not owned by the allocator is never recycled
+    std::vector<char> v(128);
+    al.recycle(v.data(), 128);
+    CHECK(al.stats().free == 0);
+
+    // Vec gives its old buffers back when it grows, and new vectors reuse them
+    LFortran::Vec<int64_t> a;
+    a.reserve(al, 8);
+    for (int64_t i = 0; i < 9; i++) a.push_back(al, i);
+    CHECK(a.capacity() == 16);
+    CHECK(al.stats().free == 64);
+    for (int64_t i = 0; i < 9; i++) CHECK(a[i] == i);
+    LFortran::Vec<int64_t> b;
+    b.reserve(al, 8);
+    CHECK(al.stats().free == 0);
+}
+
+TEST_CASE("Test LFortran::Allocator checkpoint") {
+    Allocator al(32);
+    int *p = al.allocate<int>(4);
+    p[0] = 5;
+    size_t used = al.stats().used;
+    {
+        ScratchScope scratch(al);
+        // Needs several new chunks
+        for (int i = 0; i < 10; i++) al.alloc(100);
+        void *q = al.alloc(128);
+        al.recycle(q, 128);
+        CHECK(al.num_chunks() > 1);
+        CHECK(al.stats().used > used);
+    }
+    CHECK(al.num_chunks() == 1);
+    CHECK(al.stats().used == used);
+    CHECK(al.stats().reserved == 40);
+    CHECK(al.stats().peak_reserved > 40);
+    CHECK(al.stats().free == 0);
+    CHECK(p[0] == 5);
+
+    Allocator::Checkpoint c = al.checkpoint();
+    int *q = al.allocate<int>(2);
+    al.rollback(c);
+    // The same memory is handed out again
+    CHECK(al.allocate<int>(2) == q);
+}
+
+TEST_CASE("Test LFortran::SymbolTable") {
+    using LFortran::SymbolTable;
+    using LFortran::ASR::symbol_t;
+    auto sym = [](size_t i) { return reinterpret_cast<symbol_t*>(i + 1); };
+    SymbolTable parent(nullptr);
+    SymbolTable child(&parent);
+    for (size_t i = 0; i < 1000; i++) {
+        parent.add_symbol("s" + std::to_string(i), sym(i));
+    }
+    child.add_symbol("s5", sym(5000));
+    CHECK(parent.get_scope().size() == 1000);
+    CHECK(parent.get_symbol("s999") == sym(999));
+    CHECK(parent.get_symbol("x") == nullptr);
+    CHECK(child.get_symbol("s6") == nullptr);
+    CHECK(child.resolve_symbol("s6") == sym(6));
+    CHECK(child.resolve_symbol("s5") == sym(5000));
+    CHECK(child.resolve_symbol("x") == nullptr);
+
+    // Replace and erase, every other symbol must stay reachable
+    parent.add_symbol("s7", sym(7000));
+    for (size_t i = 0; i < 1000; i += 3) {
+        parent.erase_symbol("s" + std::to_string(i));
+    }
+    for (size_t i = 0; i < 1000; i++) {
+        symbol_t *expected = (i % 3 == 0) ? nullptr
+            : (i == 7 ? sym(7000) : sym(i));
+        CHECK(parent.get_symbol("s" + std::to_string(i)) == expected);
+    }
+    CHECK(parent.get_scope().size() == 666);
+    CHECK(child.resolve_symbol("s0") == nullptr);
+
+    // The iteration order is the sorted order of the names
+    CHECK(parent.get_scope().begin()->first == "s1");
+    CHECK(parent.get_unique_name("s1") == "s12");
+}
@@ -1,4 +1,4 @@
-from ltypes import i32, i64, f64, f32, ccall, vectorize, overload
+from ltypes import i32, i64, f64, f32, ccall, vectorize, overload, CPtr
 
 pi_64: f64 = f64(3.141592653589793238462643383279502884197)
 pi_32: f32 = f32(3.141592653589793238462643383279502884197)
@@ -409,3 +409,58 @@ def ceil(x: f32) -> f32:
     if x <= f32(0) or x == resultf:
         return resultf
     return resultf + f32(1)
+
+
+########## vectorized kernels ##########
+
+# Whole array versions of the C functions above. The array_op pass lowers a
+# `@vectorize` function that just returns `_lfortran_<name>(x)` applied to an
+# array to a single call of `_lfortran_v<name>` declared here.
+
+@ccall
+def _lfortran_vdsin(n: i64, x: CPtr, y: CPtr):
+    pass
+
+@ccall
+def _lfortran_vssin(n: i64, x: CPtr, y: CPtr):
+    pass
+
+@ccall
+def _lfortran_vdcos(n: i64, x: CPtr, y: CPtr):
+    pass
+
+@ccall
+def _lfortran_vscos(n: i64, x: CPtr, y: CPtr):
+    pass
+
+@ccall
+def _lfortran_vdtan(n: i64, x: CPtr, y: CPtr):
+    pass
+
+@ccall
+def _lfortran_vstan(n: i64, x: CPtr, y: CPtr):
+    pass
+
+@ccall
+def _lfortran_vdtanh(n: i64, x: CPtr, y: CPtr):
+    pass
+
+@ccall
+def _lfortran_vstanh(n: i64, x: CPtr, y: CPtr):
+    pass
+
+@ccall
+def _lfortran_vdexp(n: i64, x: CPtr, y: CPtr):
+    pass
+
+@ccall
+def _lfortran_vsexp(n: i64, x: CPtr, y: CPtr):
+    pass
+
+@ccall
+def _lfortran_vdlog(n: i64, x: CPtr, y: CPtr):
+    pass
+
+@ccall
+def _lfortran_vslog(n: i64, x: CPtr, y: CPtr):
+    pass